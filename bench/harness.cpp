@@ -0,0 +1,350 @@
+// Native benchmarks for the nanodbc layer underneath odbc.
+//
+// Times the same fetch and bind patterns as `bench.R`, but straight through
+// nanodbc, so that a regression can be placed either in nanodbc and the
+// driver, or in odbc's conversion to and from R.
+//
+// Usage: harness <connection string> [rows] [reps]
+//
+// Prints one CSV row per benchmark to stdout.  See `README.md`.
+
+#include "nanodbc.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+enum column_type { integer_col, double_col, string_col, blob_col };
+
+struct column_spec {
+  column_type type;
+  size_t length; // For strings and blobs.
+};
+
+const char* const table = "odbc_bench_native";
+
+std::mt19937 rng(20240101);
+std::string dbms;
+int reps = 5;
+
+double median(std::vector<double> x) {
+  std::sort(x.begin(), x.end());
+  size_t n = x.size();
+  return n % 2 ? x[n / 2] : (x[n / 2 - 1] + x[n / 2]) / 2;
+}
+
+std::vector<double> time_reps(std::function<void()> const& fn) {
+  std::vector<double> times;
+  for (int i = 0; i < reps; ++i) {
+    auto start = clock_type::now();
+    fn();
+    times.push_back(
+        std::chrono::duration<double>(clock_type::now() - start).count());
+  }
+  return times;
+}
+
+void print_header() {
+  std::cout << "dbms,benchmark,parameter,value,rows,reps,median_seconds,"
+               "min_seconds,rows_per_second\n";
+}
+
+void print(
+    std::string const& benchmark,
+    std::string const& parameter,
+    std::string const& value,
+    long rows,
+    std::vector<double> const& times) {
+  double seconds = median(times);
+  std::cout << dbms << "," << benchmark << "," << parameter << "," << value
+            << "," << rows << "," << times.size() << "," << seconds << ","
+            << *std::min_element(times.begin(), times.end()) << ",";
+  if (rows > 0) {
+    std::cout << rows / seconds;
+  } else {
+    std::cout << "NA";
+  }
+  std::cout << std::endl;
+}
+
+std::string sql_type(column_spec const& col) {
+  switch (col.type) {
+  case integer_col:
+    return "INTEGER";
+  case double_col:
+    return "DOUBLE PRECISION";
+  case string_col:
+    return "VARCHAR(" + std::to_string(col.length) + ")";
+  case blob_col:
+    return dbms == "PostgreSQL" ? "BYTEA" : "BLOB";
+  }
+  return "";
+}
+
+void create_table(
+    nanodbc::connection& conn, std::vector<column_spec> const& columns) {
+  nanodbc::just_execute(conn, std::string("DROP TABLE IF EXISTS ") + table);
+  std::string sql = std::string("CREATE TABLE ") + table + " (";
+  for (size_t i = 0; i < columns.size(); ++i) {
+    sql += (i ? ", c" : "c") + std::to_string(i) + " " + sql_type(columns[i]);
+  }
+  nanodbc::just_execute(conn, sql + ")");
+}
+
+std::string insert_sql(size_t ncols) {
+  std::string sql = std::string("INSERT INTO ") + table + " VALUES (";
+  for (size_t i = 0; i < ncols; ++i) {
+    sql += i ? ", ?" : "?";
+  }
+  return sql + ")";
+}
+
+// Column values for `rows` rows, kept alive while they are bound.
+struct column_data {
+  std::vector<int> integers;
+  std::vector<double> doubles;
+  std::vector<std::string> strings;
+  std::vector<std::vector<uint8_t>> blobs;
+  std::unique_ptr<bool[]> nulls;
+};
+
+std::vector<column_data> make_data(
+    std::vector<column_spec> const& columns, size_t rows, double null_density) {
+  std::uniform_int_distribution<int> integers(0, 1000000);
+  std::uniform_real_distribution<double> unit(0, 1);
+  std::uniform_int_distribution<int> chars('a', 'z');
+  std::vector<column_data> data(columns.size());
+  for (size_t c = 0; c < columns.size(); ++c) {
+    auto& d = data[c];
+    d.nulls.reset(new bool[rows]);
+    for (size_t i = 0; i < rows; ++i) {
+      d.nulls[i] = unit(rng) < null_density;
+      switch (columns[c].type) {
+      case integer_col:
+        d.integers.push_back(integers(rng));
+        break;
+      case double_col:
+        d.doubles.push_back(unit(rng));
+        break;
+      case string_col: {
+        std::string x(columns[c].length, 'a');
+        for (auto& ch : x) {
+          ch = static_cast<char>(chars(rng));
+        }
+        d.strings.push_back(x);
+        break;
+      }
+      case blob_col:
+        d.blobs.push_back(std::vector<uint8_t>(
+            columns[c].length, static_cast<uint8_t>(integers(rng))));
+        break;
+      }
+    }
+  }
+  return data;
+}
+
+// Insert `data` in batches of `batch_rows`, as `odbc_result::bind_list`
+// does.
+void insert(
+    nanodbc::connection& conn,
+    std::vector<column_spec> const& columns,
+    std::vector<column_data> const& data,
+    size_t rows,
+    size_t batch_rows) {
+  nanodbc::transaction transaction(conn);
+  nanodbc::statement statement(conn, insert_sql(columns.size()));
+  for (size_t start = 0; start < rows; start += batch_rows) {
+    size_t size = std::min(batch_rows, rows - start);
+    statement.reset_parameters();
+    for (size_t c = 0; c < columns.size(); ++c) {
+      auto const& d = data[c];
+      short param = static_cast<short>(c);
+      bool const* nulls = d.nulls.get() + start;
+      switch (columns[c].type) {
+      case integer_col:
+        statement.bind(param, d.integers.data() + start, size, nulls);
+        break;
+      case double_col:
+        statement.bind(param, d.doubles.data() + start, size, nulls);
+        break;
+      case string_col:
+        statement.bind_strings(
+            param,
+            std::vector<std::string>(
+                d.strings.begin() + start, d.strings.begin() + start + size),
+            nulls);
+        break;
+      case blob_col:
+        statement.bind(
+            param,
+            std::vector<std::vector<uint8_t>>(
+                d.blobs.begin() + start, d.blobs.begin() + start + size),
+            nulls);
+        break;
+      }
+    }
+    nanodbc::execute(statement, static_cast<long>(size));
+  }
+  transaction.commit();
+}
+
+// Read every value of every row, as `odbc_result::result_to_dataframe`
+// does.
+long fetch_all(nanodbc::connection& conn, std::vector<column_spec> const& columns) {
+  nanodbc::result result =
+      nanodbc::execute(conn, std::string("SELECT * FROM ") + table);
+  long rows = 0;
+  std::string string_value;
+  std::vector<uint8_t> blob_value;
+  while (result.next()) {
+    for (short c = 0; c < static_cast<short>(columns.size()); ++c) {
+      if (result.is_null(c)) {
+        continue;
+      }
+      switch (columns[c].type) {
+      case integer_col:
+        result.get<int>(c);
+        break;
+      case double_col:
+        result.get<double>(c);
+        break;
+      case string_col:
+        result.get_ref<std::string>(c, string_value);
+        break;
+      case blob_col:
+        result.get_ref<std::vector<uint8_t>>(c, blob_value);
+        break;
+      }
+    }
+    ++rows;
+  }
+  return rows;
+}
+
+void bench_fetch(
+    nanodbc::connection& conn,
+    std::string const& benchmark,
+    std::string const& parameter,
+    std::string const& value,
+    std::vector<column_spec> const& columns,
+    size_t rows,
+    double null_density = 0) {
+  create_table(conn, columns);
+  auto data = make_data(columns, rows, null_density);
+  insert(conn, columns, data, rows, 1024);
+  fetch_all(conn, columns); // warm up
+  print(benchmark, parameter, value, rows, time_reps([&]() {
+          fetch_all(conn, columns);
+        }));
+}
+
+void bench_insert(nanodbc::connection& conn, size_t rows, size_t batch_rows) {
+  std::vector<column_spec> columns = {
+      {integer_col, 0}, {double_col, 0}, {string_col, 10}};
+  create_table(conn, columns);
+  auto data = make_data(columns, rows, 0);
+  print(
+      "append", "batch_rows", std::to_string(batch_rows), rows,
+      time_reps([&]() {
+        nanodbc::just_execute(conn, std::string("DELETE FROM ") + table);
+        insert(conn, columns, data, rows, batch_rows);
+      }));
+}
+
+void bench_connect(std::string const& connection_string) {
+  int saved = reps;
+  reps = std::max(reps, 20);
+  print("connect", "pool", "FALSE", 0, time_reps([&]() {
+          nanodbc::connection conn(connection_string);
+          conn.disconnect();
+        }));
+  reps = saved;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <connection string> [rows] [reps]\n";
+    return 1;
+  }
+  std::string connection_string = argv[1];
+  size_t rows = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000;
+  reps = argc > 3 ? std::atoi(argv[3]) : 5;
+
+  try {
+    nanodbc::connection conn(connection_string);
+    dbms = conn.dbms_name();
+    print_header();
+
+    struct {
+      const char* name;
+      column_spec spec;
+    } types[] = {
+        {"integer", {integer_col, 0}},
+        {"double", {double_col, 0}},
+        {"string", {string_col, 10}},
+    };
+    for (auto const& type : types) {
+      bench_fetch(
+          conn, "fetch_type", "type", type.name,
+          std::vector<column_spec>(5, type.spec), rows);
+    }
+
+    for (size_t width : {1, 10, 50}) {
+      std::vector<column_spec> columns;
+      for (size_t i = 0; i < width; ++i) {
+        columns.push_back(
+            {i % 3 == 0 ? integer_col : i % 3 == 1 ? double_col : string_col,
+             10});
+      }
+      bench_fetch(
+          conn, "fetch_width", "columns", std::to_string(width), columns, rows);
+    }
+
+    for (double density : {0.0, 0.5, 0.9}) {
+      std::vector<column_spec> columns = {
+          {integer_col, 0}, {double_col, 0}, {string_col, 10}};
+      bench_fetch(
+          conn, "fetch_nulls", "null_density", std::to_string(density),
+          columns, rows, density);
+    }
+
+    for (size_t length : {10, 255, 4000}) {
+      bench_fetch(
+          conn, "fetch_string", "length", std::to_string(length),
+          {{string_col, length}}, rows / 10);
+    }
+
+    for (size_t length : {100, 10000}) {
+      bench_fetch(
+          conn, "fetch_blob", "bytes", std::to_string(length),
+          {{blob_col, length}}, rows / 100);
+    }
+
+    for (size_t batch_rows : {1, 100, 1024, 10000}) {
+      bench_insert(conn, rows / 10, batch_rows);
+    }
+
+    nanodbc::just_execute(conn, std::string("DROP TABLE IF EXISTS ") + table);
+    conn.disconnect();
+
+    bench_connect(connection_string);
+  } catch (std::exception const& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,1504 @@
+// A mock ODBC driver that makes up its data.
+//
+// Loaded through the driver manager like any other driver, it answers
+// queries with result sets generated on the fly and accepts inserts without
+// storing anything, so that odbc's own fetch and bind overhead can be
+// measured without a database server.
+//
+// Statements are not SQL.  A query names the shape of its result:
+//
+//   SELECT rows=100000 nulls=0.1 cols=integer,double,varchar(20),date
+//
+// Column types are bit, integer, bigint, double, varchar(n), wvarchar(n),
+// longvarchar(n), varbinary(n), longvarbinary(n), date and timestamp; the
+// columns are named c1, c2, ....  Values only depend on the row and column,
+// and `nulls` is the share of NULL values.  A statement starting with INSERT
+// consumes its bound parameter arrays.  Catalog functions return empty
+// results, and anything else succeeds without a result.  See `README.md`.
+
+#include <sql.h>
+#include <sqlext.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum handle_kind { env_handle, dbc_handle, stmt_handle };
+
+struct diagnostic {
+  std::string state;
+  std::string message;
+};
+
+struct handle {
+  explicit handle(handle_kind kind) : kind(kind) {}
+  handle_kind kind;
+  std::vector<diagnostic> diagnostics;
+};
+
+struct env : handle {
+  env() : handle(env_handle) {}
+  SQLINTEGER odbc_version = SQL_OV_ODBC3;
+};
+
+struct dbc : handle {
+  dbc() : handle(dbc_handle) {}
+  std::string connection_string;
+  SQLUINTEGER autocommit = SQL_AUTOCOMMIT_ON;
+  SQLUINTEGER txn_isolation = SQL_TXN_READ_COMMITTED;
+};
+
+enum column_kind {
+  bit_col,
+  integer_col,
+  bigint_col,
+  double_col,
+  varchar_col,
+  wvarchar_col,
+  longvarchar_col,
+  varbinary_col,
+  longvarbinary_col,
+  date_col,
+  timestamp_col
+};
+
+struct column {
+  std::string name;
+  column_kind kind;
+  SQLSMALLINT sql_type;
+  SQLULEN size; // Characters or bytes of every value, for variable types.
+};
+
+struct binding {
+  SQLSMALLINT c_type;
+  SQLPOINTER target;
+  SQLLEN length;
+  SQLLEN* indicator;
+};
+
+struct parameter {
+  SQLSMALLINT c_type;
+  SQLPOINTER value;
+  SQLLEN length;
+  SQLLEN* indicator;
+};
+
+struct stmt : handle {
+  explicit stmt(dbc* conn) : handle(stmt_handle), conn(conn) {}
+  dbc* conn;
+
+  // The prepared statement.
+  bool insert = false;
+  bool has_result = false;
+  std::vector<column> columns;
+  long rows = 0;
+  double nulls = 0;
+  SQLSMALLINT num_params = 0;
+
+  // The open cursor: the first row of the current rowset, -1 before the
+  // first rowset and `rows` after the last.
+  bool open = false;
+  long position = -1;
+  SQLLEN row_count = -1;
+
+  // SQLGetData() state, reset by every fetch.
+  SQLUSMALLINT get_data_column = 0;
+  size_t get_data_offset = 0;
+
+  std::map<SQLUSMALLINT, binding> bindings;
+  std::map<SQLUSMALLINT, parameter> parameters;
+
+  SQLULEN row_array_size = 1;
+  SQLULEN row_bind_type = SQL_BIND_BY_COLUMN;
+  SQLULEN* rows_fetched = nullptr;
+  SQLUSMALLINT* row_status = nullptr;
+  SQLULEN paramset_size = 1;
+  SQLULEN* params_processed = nullptr;
+  SQLUSMALLINT* param_status = nullptr;
+  std::map<SQLINTEGER, SQLULEN> attributes;
+
+  // Checksum of the parameter data consumed, so that reading it can't be
+  // optimised away.
+  uint64_t sink = 0;
+};
+
+template <class T> T* as(SQLHANDLE h, handle_kind kind) {
+  handle* x = static_cast<handle*>(h);
+  if (x == nullptr || x->kind != kind) {
+    return nullptr;
+  }
+  x->diagnostics.clear();
+  return static_cast<T*>(x);
+}
+
+SQLRETURN fail(handle& h, const char* state, std::string const& message) {
+  h.diagnostics.push_back({state, "[odbc][mock]" + message});
+  return SQL_ERROR;
+}
+
+SQLRETURN warn(handle& h, const char* state, std::string const& message) {
+  h.diagnostics.push_back({state, "[odbc][mock]" + message});
+  return SQL_SUCCESS_WITH_INFO;
+}
+
+// Copies `value` to an application buffer of `buffer_length` bytes,
+// truncating and null terminating it as ODBC does.
+template <class Length>
+SQLRETURN put_string(
+    handle& h,
+    std::string const& value,
+    SQLPOINTER buffer,
+    SQLLEN buffer_length,
+    Length* length) {
+  if (length != nullptr) {
+    *length = static_cast<Length>(value.size());
+  }
+  if (buffer == nullptr || buffer_length <= 0) {
+    return SQL_SUCCESS;
+  }
+  size_t n = std::min(value.size(), static_cast<size_t>(buffer_length - 1));
+  std::memcpy(buffer, value.data(), n);
+  static_cast<char*>(buffer)[n] = '\0';
+  if (n < value.size()) {
+    return warn(h, "01004", "String data, right truncated");
+  }
+  return SQL_SUCCESS;
+}
+
+std::string to_string(SQLCHAR* text, SQLINTEGER length) {
+  if (text == nullptr) {
+    return std::string();
+  }
+  if (length == SQL_NTS) {
+    return std::string(reinterpret_cast<char*>(text));
+  }
+  return std::string(reinterpret_cast<char*>(text), length);
+}
+
+std::string lower(std::string x) {
+  for (auto& c : x) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return x;
+}
+
+// Values ---------------------------------------------------------------------
+
+// Deterministic number in [0, 1) for a cell.
+double cell_hash(long row, size_t col) {
+  uint64_t x = static_cast<uint64_t>(row) * 0x9E3779B97F4A7C15ULL ^
+               static_cast<uint64_t>(col + 1) * 0xC2B2AE3D27D4EB4FULL;
+  x ^= x >> 33;
+  x *= 0xFF51AFD7ED558CCDULL;
+  x ^= x >> 33;
+  return static_cast<double>(x >> 11) / 9007199254740992.0;
+}
+
+bool is_null(stmt const& s, long row, size_t col) {
+  return s.nulls > 0 && cell_hash(row, col) < s.nulls;
+}
+
+int64_t integer_value(column const& c, long row) {
+  switch (c.kind) {
+  case bit_col:
+    return row % 2;
+  case integer_col:
+    return row % 2147483647;
+  case bigint_col:
+    return static_cast<int64_t>(row) * 1000003;
+  default:
+    return static_cast<int64_t>(row) / 4;
+  }
+}
+
+double double_value(column const& c, long row) {
+  return c.kind == double_col ? row * 0.25 : integer_value(c, row);
+}
+
+// Dates count days from 2000-01-01, timestamps add seconds to that.
+void civil_from_days(long z, SQLSMALLINT& y, SQLUSMALLINT& m, SQLUSMALLINT& d) {
+  z += 719468;
+  long era = (z >= 0 ? z : z - 146096) / 146097;
+  long doe = z - era * 146097;
+  long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  long mp = (5 * doy + 2) / 153;
+  d = static_cast<SQLUSMALLINT>(doy - (153 * mp + 2) / 5 + 1);
+  m = static_cast<SQLUSMALLINT>(mp < 10 ? mp + 3 : mp - 9);
+  y = static_cast<SQLSMALLINT>(yoe + era * 400 + (m <= 2));
+}
+
+TIMESTAMP_STRUCT timestamp_value(column const& c, long row) {
+  TIMESTAMP_STRUCT ts = {};
+  civil_from_days(10957 + row % 10000, ts.year, ts.month, ts.day);
+  if (c.kind == timestamp_col) {
+    long seconds = (row * 7919L) % 86400;
+    ts.hour = static_cast<SQLUSMALLINT>(seconds / 3600);
+    ts.minute = static_cast<SQLUSMALLINT>(seconds / 60 % 60);
+    ts.second = static_cast<SQLUSMALLINT>(seconds % 60);
+  }
+  return ts;
+}
+
+std::string text_value(column const& c, long row) {
+  char buf[32];
+  switch (c.kind) {
+  case double_col:
+    std::snprintf(buf, sizeof(buf), "%.17g", double_value(c, row));
+    return buf;
+  case date_col:
+  case timestamp_col: {
+    TIMESTAMP_STRUCT ts = timestamp_value(c, row);
+    if (c.kind == date_col) {
+      std::snprintf(buf, sizeof(buf), "%04d-%02u-%02u", ts.year, ts.month, ts.day);
+    } else {
+      std::snprintf(
+          buf, sizeof(buf), "%04d-%02u-%02u %02u:%02u:%02u", ts.year, ts.month,
+          ts.day, ts.hour, ts.minute, ts.second);
+    }
+    return buf;
+  }
+  default:
+    return std::to_string(integer_value(c, row));
+  }
+}
+
+bool is_text(column const& c) {
+  return c.kind == varchar_col || c.kind == wvarchar_col ||
+         c.kind == longvarchar_col;
+}
+
+bool is_binary(column const& c) {
+  return c.kind == varbinary_col || c.kind == longvarbinary_col;
+}
+
+// Writes characters [offset, total) of a value, as far as they fit, and
+// advances `offset`.
+template <class CharT, class Generator>
+SQLRETURN put_chars(
+    stmt& s,
+    Generator gen,
+    size_t total,
+    size_t& offset,
+    SQLPOINTER target,
+    SQLLEN buffer_length,
+    SQLLEN* indicator,
+    bool terminate) {
+  if (offset > 0 && offset >= total) {
+    return SQL_NO_DATA;
+  }
+  size_t remaining = total - offset;
+  size_t room = buffer_length > 0 ? buffer_length / sizeof(CharT) : 0;
+  if (terminate && room > 0) {
+    --room;
+  }
+  size_t n = std::min(remaining, room);
+  CharT* out = static_cast<CharT*>(target);
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<CharT>(gen(offset + i));
+  }
+  if (terminate && buffer_length >= static_cast<SQLLEN>(sizeof(CharT))) {
+    out[n] = 0;
+  }
+  if (indicator != nullptr) {
+    *indicator = static_cast<SQLLEN>(remaining * sizeof(CharT));
+  }
+  offset += n;
+  if (n < remaining) {
+    return warn(s, "01004", "String data, right truncated");
+  }
+  return SQL_SUCCESS;
+}
+
+template <class T>
+SQLRETURN put_fixed(T value, SQLPOINTER target, SQLLEN* indicator) {
+  std::memcpy(target, &value, sizeof(T));
+  if (indicator != nullptr) {
+    *indicator = sizeof(T);
+  }
+  return SQL_SUCCESS;
+}
+
+// Writes the value of column `col` in `row` as `c_type`.  `offset` is the
+// part of a character or binary value already returned by SQLGetData().
+SQLRETURN put_value(
+    stmt& s,
+    size_t col,
+    long row,
+    SQLSMALLINT c_type,
+    SQLPOINTER target,
+    SQLLEN buffer_length,
+    SQLLEN* indicator,
+    size_t& offset) {
+  column const& c = s.columns[col];
+  if (is_null(s, row, col)) {
+    if (offset > 0) {
+      return SQL_NO_DATA;
+    }
+    if (indicator == nullptr) {
+      return fail(s, "22002", "Indicator variable required but not supplied");
+    }
+    *indicator = SQL_NULL_DATA;
+    offset = 1;
+    return SQL_SUCCESS;
+  }
+
+  if (is_text(c) || is_binary(c)) {
+    auto gen = [row](size_t i) {
+      return static_cast<unsigned char>('a' + (row + i) % 26);
+    };
+    switch (c_type) {
+    case SQL_C_CHAR:
+      return put_chars<char>(
+          s, gen, c.size, offset, target, buffer_length, indicator, true);
+    case SQL_C_WCHAR:
+      return put_chars<SQLWCHAR>(
+          s, gen, c.size, offset, target, buffer_length, indicator, true);
+    case SQL_C_BINARY:
+      return put_chars<unsigned char>(
+          s, gen, c.size, offset, target, buffer_length, indicator, false);
+    }
+    return fail(s, "07006", "Restricted data type attribute violation");
+  }
+
+  if (c_type == SQL_C_CHAR || c_type == SQL_C_WCHAR) {
+    std::string x = text_value(c, row);
+    auto gen = [&x](size_t i) { return static_cast<unsigned char>(x[i]); };
+    if (c_type == SQL_C_CHAR) {
+      return put_chars<char>(
+          s, gen, x.size(), offset, target, buffer_length, indicator, true);
+    }
+    return put_chars<SQLWCHAR>(
+        s, gen, x.size(), offset, target, buffer_length, indicator, true);
+  }
+
+  if (offset > 0) {
+    return SQL_NO_DATA;
+  }
+  offset = 1;
+
+  if (c.kind == date_col || c.kind == timestamp_col) {
+    TIMESTAMP_STRUCT ts = timestamp_value(c, row);
+    switch (c_type) {
+    case SQL_C_DATE:
+    case SQL_C_TYPE_DATE: {
+      DATE_STRUCT d = {ts.year, ts.month, ts.day};
+      return put_fixed(d, target, indicator);
+    }
+    case SQL_C_TIMESTAMP:
+    case SQL_C_TYPE_TIMESTAMP:
+      return put_fixed(ts, target, indicator);
+    }
+    return fail(s, "07006", "Restricted data type attribute violation");
+  }
+
+  int64_t i = integer_value(c, row);
+  double d = double_value(c, row);
+  switch (c_type) {
+  case SQL_C_SBIGINT:
+    return put_fixed(static_cast<SQLBIGINT>(c.kind == double_col ? d : i), target, indicator);
+  case SQL_C_SLONG:
+  case SQL_C_LONG:
+    return put_fixed(static_cast<SQLINTEGER>(c.kind == double_col ? d : i), target, indicator);
+  case SQL_C_SSHORT:
+  case SQL_C_SHORT:
+    return put_fixed(static_cast<SQLSMALLINT>(i), target, indicator);
+  case SQL_C_BIT:
+  case SQL_C_UTINYINT:
+  case SQL_C_STINYINT:
+  case SQL_C_TINYINT:
+    return put_fixed(static_cast<unsigned char>(i), target, indicator);
+  case SQL_C_DOUBLE:
+    return put_fixed(static_cast<SQLDOUBLE>(d), target, indicator);
+  case SQL_C_FLOAT:
+    return put_fixed(static_cast<SQLREAL>(d), target, indicator);
+  }
+  return fail(s, "07006", "Restricted data type attribute violation");
+}
+
+// Size of one element of a bound array, for column-wise binding.
+SQLLEN element_size(SQLSMALLINT c_type, SQLLEN buffer_length) {
+  switch (c_type) {
+  case SQL_C_SBIGINT:
+  case SQL_C_UBIGINT:
+  case SQL_C_DOUBLE:
+    return 8;
+  case SQL_C_SLONG:
+  case SQL_C_LONG:
+  case SQL_C_ULONG:
+  case SQL_C_FLOAT:
+    return 4;
+  case SQL_C_SSHORT:
+  case SQL_C_SHORT:
+  case SQL_C_USHORT:
+    return 2;
+  case SQL_C_BIT:
+  case SQL_C_STINYINT:
+  case SQL_C_UTINYINT:
+  case SQL_C_TINYINT:
+    return 1;
+  case SQL_C_DATE:
+  case SQL_C_TYPE_DATE:
+    return sizeof(DATE_STRUCT);
+  case SQL_C_TIME:
+  case SQL_C_TYPE_TIME:
+    return sizeof(TIME_STRUCT);
+  case SQL_C_TIMESTAMP:
+  case SQL_C_TYPE_TIMESTAMP:
+    return sizeof(TIMESTAMP_STRUCT);
+  }
+  return buffer_length;
+}
+
+// Statements -----------------------------------------------------------------
+
+bool parse_column(std::string const& spec, size_t i, column& out) {
+  std::string type = spec;
+  SQLULEN size = 0;
+  size_t paren = spec.find('(');
+  if (paren != std::string::npos) {
+    type = spec.substr(0, paren);
+    size = std::strtoul(spec.c_str() + paren + 1, nullptr, 10);
+  }
+  static const struct {
+    const char* name;
+    column_kind kind;
+    SQLSMALLINT sql_type;
+    SQLULEN size;
+  } types[] = {
+      {"bit", bit_col, SQL_BIT, 1},
+      {"integer", integer_col, SQL_INTEGER, 10},
+      {"bigint", bigint_col, SQL_BIGINT, 19},
+      {"double", double_col, SQL_DOUBLE, 15},
+      {"varchar", varchar_col, SQL_VARCHAR, 255},
+      {"wvarchar", wvarchar_col, SQL_WVARCHAR, 255},
+      {"longvarchar", longvarchar_col, SQL_LONGVARCHAR, 4000},
+      {"varbinary", varbinary_col, SQL_VARBINARY, 255},
+      {"longvarbinary", longvarbinary_col, SQL_LONGVARBINARY, 4000},
+      {"date", date_col, SQL_TYPE_DATE, 10},
+      {"timestamp", timestamp_col, SQL_TYPE_TIMESTAMP, 19},
+  };
+  for (auto const& t : types) {
+    if (type == t.name) {
+      out.name = "c" + std::to_string(i + 1);
+      out.kind = t.kind;
+      out.sql_type = t.sql_type;
+      out.size = size > 0 ? size : t.size;
+      return true;
+    }
+  }
+  return false;
+}
+
+SQLRETURN prepare(stmt& s, std::string const& sql) {
+  s.insert = false;
+  s.has_result = false;
+  s.columns.clear();
+  s.rows = 0;
+  s.nulls = 0;
+  s.num_params = 0;
+  s.open = false;
+
+  std::string text = lower(sql);
+  size_t start = text.find_first_not_of(" \t\r\n");
+  if (start != std::string::npos && text.compare(start, 6, "insert") == 0) {
+    s.insert = true;
+    s.num_params = static_cast<SQLSMALLINT>(std::count(text.begin(), text.end(), '?'));
+    return SQL_SUCCESS;
+  }
+  if (text.find("rows=") == std::string::npos &&
+      text.find("cols=") == std::string::npos) {
+    return SQL_SUCCESS;
+  }
+
+  s.has_result = true;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t end = text.find_first_of(" \t\r\n;", pos);
+    if (end == std::string::npos) {
+      end = text.size();
+    }
+    std::string token = text.substr(pos, end - pos);
+    pos = end + 1;
+    if (token.compare(0, 5, "rows=") == 0) {
+      s.rows = std::strtol(token.c_str() + 5, nullptr, 10);
+    } else if (token.compare(0, 6, "nulls=") == 0) {
+      s.nulls = std::strtod(token.c_str() + 6, nullptr);
+    } else if (token.compare(0, 5, "cols=") == 0) {
+      std::string specs = token.substr(5);
+      size_t from = 0;
+      while (from <= specs.size()) {
+        size_t comma = specs.find(',', from);
+        if (comma == std::string::npos) {
+          comma = specs.size();
+        }
+        column c;
+        if (!parse_column(specs.substr(from, comma - from), s.columns.size(), c)) {
+          return fail(
+              s, "42000", "Unknown column type '" +
+                              specs.substr(from, comma - from) + "'");
+        }
+        s.columns.push_back(c);
+        from = comma + 1;
+      }
+    } else if (!token.empty() && token != "select") {
+      return fail(s, "42000", "Syntax error at '" + token + "'");
+    }
+  }
+  if (s.columns.empty()) {
+    return fail(s, "42000", "A query needs at least one column in 'cols='");
+  }
+  return SQL_SUCCESS;
+}
+
+// An empty result with the given VARCHAR columns, for catalog functions.
+SQLRETURN empty_result(stmt& s, std::vector<const char*> const& names) {
+  prepare(s, "");
+  s.has_result = true;
+  for (auto name : names) {
+    s.columns.push_back({name, varchar_col, SQL_VARCHAR, 128});
+  }
+  s.open = true;
+  s.position = -1;
+  s.row_count = -1;
+  return SQL_SUCCESS;
+}
+
+// Reads every bound parameter value, as a driver sending them would.
+void consume_parameters(stmt& s) {
+  for (auto const& p : s.parameters) {
+    parameter const& x = p.second;
+    SQLLEN size = element_size(x.c_type, x.length);
+    for (SQLULEN i = 0; i < s.paramset_size; ++i) {
+      SQLLEN len = x.indicator != nullptr ? x.indicator[i] : size;
+      if (len == SQL_NULL_DATA || x.value == nullptr) {
+        continue;
+      }
+      const unsigned char* value =
+          static_cast<const unsigned char*>(x.value) + i * size;
+      if (len == SQL_NTS) {
+        len = static_cast<SQLLEN>(std::strlen(reinterpret_cast<const char*>(value)));
+      }
+      len = std::min(len, size);
+      for (SQLLEN j = 0; j < len; ++j) {
+        s.sink = s.sink * 31 + value[j];
+      }
+    }
+  }
+}
+
+SQLRETURN execute(stmt& s) {
+  s.open = false;
+  s.position = -1;
+  if (s.insert) {
+    if (s.parameters.size() < static_cast<size_t>(s.num_params)) {
+      return fail(s, "07002", "COUNT field incorrect");
+    }
+    consume_parameters(s);
+    if (s.params_processed != nullptr) {
+      *s.params_processed = s.paramset_size;
+    }
+    if (s.param_status != nullptr) {
+      std::fill(s.param_status, s.param_status + s.paramset_size, SQL_PARAM_SUCCESS);
+    }
+    s.row_count = static_cast<SQLLEN>(s.paramset_size);
+    return SQL_SUCCESS;
+  }
+  s.open = s.has_result;
+  s.row_count = s.has_result ? -1 : 0;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN fetch_rowset(stmt& s, long start) {
+  if (!s.open) {
+    return fail(s, "24000", "Invalid cursor state");
+  }
+  s.get_data_column = 0;
+  s.get_data_offset = 0;
+  if (start < 0 || start >= s.rows) {
+    s.position = start < 0 ? -1 : s.rows;
+    if (s.rows_fetched != nullptr) {
+      *s.rows_fetched = 0;
+    }
+    return SQL_NO_DATA;
+  }
+  s.position = start;
+  SQLULEN n = std::min<SQLULEN>(s.row_array_size, s.rows - start);
+
+  SQLRETURN rc = SQL_SUCCESS;
+  for (auto const& b : s.bindings) {
+    size_t col = b.first - 1;
+    binding const& x = b.second;
+    if (x.target == nullptr && x.indicator == nullptr) {
+      continue;
+    }
+    SQLLEN stride = s.row_bind_type == SQL_BIND_BY_COLUMN
+                        ? element_size(x.c_type, x.length)
+                        : static_cast<SQLLEN>(s.row_bind_type);
+    for (SQLULEN i = 0; i < n; ++i) {
+      char* target = static_cast<char*>(x.target) + i * stride;
+      SQLLEN* indicator =
+          x.indicator == nullptr
+              ? nullptr
+              : s.row_bind_type == SQL_BIND_BY_COLUMN
+                    ? x.indicator + i
+                    : reinterpret_cast<SQLLEN*>(
+                          reinterpret_cast<char*>(x.indicator) + i * stride);
+      size_t offset = 0;
+      SQLRETURN r = put_value(
+          s, col, start + static_cast<long>(i), x.c_type, target, x.length,
+          indicator, offset);
+      if (r == SQL_ERROR) {
+        return r;
+      }
+      if (r == SQL_SUCCESS_WITH_INFO) {
+        rc = r;
+      }
+    }
+  }
+  if (s.rows_fetched != nullptr) {
+    *s.rows_fetched = n;
+  }
+  if (s.row_status != nullptr) {
+    std::fill(s.row_status, s.row_status + n, SQL_ROW_SUCCESS);
+    std::fill(s.row_status + n, s.row_status + s.row_array_size, SQL_ROW_NOROW);
+  }
+  return rc;
+}
+
+void close_cursor(stmt& s) {
+  s.open = false;
+  s.position = -1;
+  s.get_data_column = 0;
+  s.get_data_offset = 0;
+}
+
+// Information ----------------------------------------------------------------
+
+bool info_string(SQLUSMALLINT type, std::string& out) {
+  switch (type) {
+  case SQL_DBMS_NAME:
+    out = "Mock";
+    return true;
+  case SQL_DBMS_VER:
+  case SQL_DRIVER_VER:
+    out = "01.00.0000";
+    return true;
+  case SQL_DRIVER_NAME:
+    out = "libodbcmock.so";
+    return true;
+  case SQL_DRIVER_ODBC_VER:
+  case SQL_ODBC_VER:
+    out = "03.80";
+    return true;
+  case SQL_DATABASE_NAME:
+  case SQL_SERVER_NAME:
+    out = "mock";
+    return true;
+  case SQL_DATA_SOURCE_NAME:
+  case SQL_USER_NAME:
+  case SQL_KEYWORDS:
+  case SQL_SPECIAL_CHARACTERS:
+  case SQL_COLLATION_SEQ:
+    out = "";
+    return true;
+  case SQL_IDENTIFIER_QUOTE_CHAR:
+    out = "\"";
+    return true;
+  case SQL_CATALOG_NAME_SEPARATOR:
+    out = ".";
+    return true;
+  case SQL_SEARCH_PATTERN_ESCAPE:
+    out = "\\";
+    return true;
+  case SQL_CATALOG_TERM:
+    out = "catalog";
+    return true;
+  case SQL_SCHEMA_TERM:
+    out = "schema";
+    return true;
+  case SQL_TABLE_TERM:
+    out = "table";
+    return true;
+  case SQL_PROCEDURE_TERM:
+    out = "procedure";
+    return true;
+  case SQL_DESCRIBE_PARAMETER:
+  case SQL_MULT_RESULT_SETS:
+  case SQL_MULTIPLE_ACTIVE_TXN:
+  case SQL_NEED_LONG_DATA_LEN:
+  case SQL_PROCEDURES:
+  case SQL_ROW_UPDATES:
+  case SQL_DATA_SOURCE_READ_ONLY:
+    out = "Y";
+    return true;
+  case SQL_CATALOG_NAME:
+  case SQL_ACCESSIBLE_TABLES:
+  case SQL_ACCESSIBLE_PROCEDURES:
+  case SQL_COLUMN_ALIAS:
+  case SQL_EXPRESSIONS_IN_ORDERBY:
+  case SQL_INTEGRITY:
+  case SQL_LIKE_ESCAPE_CLAUSE:
+  case SQL_MAX_ROW_SIZE_INCLUDES_LONG:
+  case SQL_ORDER_BY_COLUMNS_IN_SELECT:
+  case SQL_OUTER_JOINS:
+    out = "N";
+    return true;
+  }
+  return false;
+}
+
+bool info_usmallint(SQLUSMALLINT type, SQLUSMALLINT& out) {
+  switch (type) {
+  case SQL_TXN_CAPABLE:
+    out = SQL_TC_ALL;
+    return true;
+  case SQL_CURSOR_COMMIT_BEHAVIOR:
+  case SQL_CURSOR_ROLLBACK_BEHAVIOR:
+    out = SQL_CB_PRESERVE;
+    return true;
+  case SQL_IDENTIFIER_CASE:
+  case SQL_QUOTED_IDENTIFIER_CASE:
+    out = SQL_IC_SENSITIVE;
+    return true;
+  case SQL_NULL_COLLATION:
+    out = SQL_NC_LOW;
+    return true;
+  case SQL_CONCAT_NULL_BEHAVIOR:
+    out = SQL_CB_NULL;
+    return true;
+  case SQL_MAX_COLUMN_NAME_LEN:
+  case SQL_MAX_CATALOG_NAME_LEN:
+  case SQL_MAX_SCHEMA_NAME_LEN:
+  case SQL_MAX_TABLE_NAME_LEN:
+  case SQL_MAX_CURSOR_NAME_LEN:
+  case SQL_MAX_IDENTIFIER_LEN:
+    out = 128;
+    return true;
+  case SQL_ACTIVE_ENVIRONMENTS:
+  case SQL_CATALOG_LOCATION:
+  case SQL_CORRELATION_NAME:
+  case SQL_FILE_USAGE:
+  case SQL_GROUP_BY:
+  case SQL_MAX_COLUMNS_IN_GROUP_BY:
+  case SQL_MAX_COLUMNS_IN_INDEX:
+  case SQL_MAX_COLUMNS_IN_ORDER_BY:
+  case SQL_MAX_COLUMNS_IN_SELECT:
+  case SQL_MAX_COLUMNS_IN_TABLE:
+  case SQL_MAX_CONCURRENT_ACTIVITIES:
+  case SQL_MAX_DRIVER_CONNECTIONS:
+  case SQL_MAX_PROCEDURE_NAME_LEN:
+  case SQL_MAX_TABLES_IN_SELECT:
+  case SQL_MAX_USER_NAME_LEN:
+  case SQL_NON_NULLABLE_COLUMNS:
+  case SQL_ODBC_API_CONFORMANCE:
+  case SQL_ODBC_SQL_CONFORMANCE:
+  case SQL_ODBC_SAG_CLI_CONFORMANCE:
+    out = 0;
+    return true;
+  }
+  return false;
+}
+
+SQLUINTEGER info_uinteger(SQLUSMALLINT type) {
+  switch (type) {
+  case SQL_GETDATA_EXTENSIONS:
+    return SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER | SQL_GD_BOUND;
+  case SQL_SCROLL_OPTIONS:
+    return SQL_SO_FORWARD_ONLY | SQL_SO_STATIC;
+  case SQL_DEFAULT_TXN_ISOLATION:
+  case SQL_TXN_ISOLATION_OPTION:
+    return SQL_TXN_READ_COMMITTED;
+  case SQL_PARAM_ARRAY_ROW_COUNTS:
+    return SQL_PARC_BATCH;
+  case SQL_PARAM_ARRAY_SELECTS:
+    return SQL_PAS_NO_SELECT;
+  }
+  // Everything else is unsupported or unlimited.
+  return 0;
+}
+
+} // namespace
+
+extern "C" {
+
+// Handles --------------------------------------------------------------------
+
+SQLRETURN SQL_API
+SQLAllocHandle(SQLSMALLINT type, SQLHANDLE input, SQLHANDLE* output) {
+  if (output == nullptr) {
+    return SQL_ERROR;
+  }
+  switch (type) {
+  case SQL_HANDLE_ENV:
+    *output = new env();
+    return SQL_SUCCESS;
+  case SQL_HANDLE_DBC:
+    if (as<env>(input, env_handle) == nullptr) {
+      return SQL_INVALID_HANDLE;
+    }
+    *output = new dbc();
+    return SQL_SUCCESS;
+  case SQL_HANDLE_STMT: {
+    dbc* conn = as<dbc>(input, dbc_handle);
+    if (conn == nullptr) {
+      return SQL_INVALID_HANDLE;
+    }
+    *output = new stmt(conn);
+    return SQL_SUCCESS;
+  }
+  }
+  *output = nullptr;
+  return SQL_ERROR;
+}
+
+SQLRETURN SQL_API SQLFreeHandle(SQLSMALLINT type, SQLHANDLE h) {
+  switch (type) {
+  case SQL_HANDLE_ENV:
+    delete as<env>(h, env_handle);
+    return SQL_SUCCESS;
+  case SQL_HANDLE_DBC:
+    delete as<dbc>(h, dbc_handle);
+    return SQL_SUCCESS;
+  case SQL_HANDLE_STMT:
+    delete as<stmt>(h, stmt_handle);
+    return SQL_SUCCESS;
+  }
+  return SQL_INVALID_HANDLE;
+}
+
+SQLRETURN SQL_API SQLSetEnvAttr(
+    SQLHENV h, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*length*/) {
+  env* e = as<env>(h, env_handle);
+  if (e == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (attribute == SQL_ATTR_ODBC_VERSION) {
+    e->odbc_version = static_cast<SQLINTEGER>(reinterpret_cast<intptr_t>(value));
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLGetEnvAttr(
+    SQLHENV h,
+    SQLINTEGER attribute,
+    SQLPOINTER value,
+    SQLINTEGER /*buffer_length*/,
+    SQLINTEGER* /*length*/) {
+  env* e = as<env>(h, env_handle);
+  if (e == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (value != nullptr) {
+    *static_cast<SQLINTEGER*>(value) =
+        attribute == SQL_ATTR_ODBC_VERSION ? e->odbc_version : 0;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLGetDiagRec(
+    SQLSMALLINT /*type*/,
+    SQLHANDLE h,
+    SQLSMALLINT record,
+    SQLCHAR* state,
+    SQLINTEGER* native,
+    SQLCHAR* message,
+    SQLSMALLINT buffer_length,
+    SQLSMALLINT* length) {
+  handle* x = static_cast<handle*>(h);
+  if (x == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (record < 1 || static_cast<size_t>(record) > x->diagnostics.size()) {
+    return SQL_NO_DATA;
+  }
+  diagnostic const& d = x->diagnostics[record - 1];
+  if (state != nullptr) {
+    std::memcpy(state, d.state.c_str(), 6);
+  }
+  if (native != nullptr) {
+    *native = 0;
+  }
+  // Don't report truncation of the message as a diagnostic of its own.
+  handle scratch(x->kind);
+  return put_string(scratch, d.message, message, buffer_length, length);
+}
+
+SQLRETURN SQL_API SQLGetDiagField(
+    SQLSMALLINT /*type*/,
+    SQLHANDLE h,
+    SQLSMALLINT record,
+    SQLSMALLINT field,
+    SQLPOINTER value,
+    SQLSMALLINT buffer_length,
+    SQLSMALLINT* length) {
+  handle* x = static_cast<handle*>(h);
+  if (x == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (record == 0 && field == SQL_DIAG_NUMBER) {
+    if (value != nullptr) {
+      *static_cast<SQLINTEGER*>(value) =
+          static_cast<SQLINTEGER>(x->diagnostics.size());
+    }
+    return SQL_SUCCESS;
+  }
+  if (record < 1 || static_cast<size_t>(record) > x->diagnostics.size()) {
+    return SQL_NO_DATA;
+  }
+  diagnostic const& d = x->diagnostics[record - 1];
+  handle scratch(x->kind);
+  switch (field) {
+  case SQL_DIAG_SQLSTATE:
+    return put_string(scratch, d.state, value, buffer_length, length);
+  case SQL_DIAG_MESSAGE_TEXT:
+    return put_string(scratch, d.message, value, buffer_length, length);
+  case SQL_DIAG_NATIVE:
+    if (value != nullptr) {
+      *static_cast<SQLINTEGER*>(value) = 0;
+    }
+    return SQL_SUCCESS;
+  }
+  return SQL_NO_DATA;
+}
+
+// Connections ----------------------------------------------------------------
+
+SQLRETURN SQL_API SQLDriverConnect(
+    SQLHDBC h,
+    SQLHWND /*window*/,
+    SQLCHAR* in,
+    SQLSMALLINT in_length,
+    SQLCHAR* out,
+    SQLSMALLINT buffer_length,
+    SQLSMALLINT* out_length,
+    SQLUSMALLINT /*completion*/) {
+  dbc* conn = as<dbc>(h, dbc_handle);
+  if (conn == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  conn->connection_string = to_string(in, in_length);
+  return put_string(*conn, conn->connection_string, out, buffer_length, out_length);
+}
+
+SQLRETURN SQL_API SQLConnect(
+    SQLHDBC h,
+    SQLCHAR* dsn,
+    SQLSMALLINT dsn_length,
+    SQLCHAR* /*user*/,
+    SQLSMALLINT /*user_length*/,
+    SQLCHAR* /*password*/,
+    SQLSMALLINT /*password_length*/) {
+  dbc* conn = as<dbc>(h, dbc_handle);
+  if (conn == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  conn->connection_string = "DSN=" + to_string(dsn, dsn_length);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLDisconnect(SQLHDBC h) {
+  return as<dbc>(h, dbc_handle) == nullptr ? SQL_INVALID_HANDLE : SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLSetConnectAttr(
+    SQLHDBC h, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*length*/) {
+  dbc* conn = as<dbc>(h, dbc_handle);
+  if (conn == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  SQLUINTEGER x = static_cast<SQLUINTEGER>(reinterpret_cast<uintptr_t>(value));
+  if (attribute == SQL_ATTR_AUTOCOMMIT) {
+    conn->autocommit = x;
+  } else if (attribute == SQL_ATTR_TXN_ISOLATION) {
+    conn->txn_isolation = x;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLGetConnectAttr(
+    SQLHDBC h,
+    SQLINTEGER attribute,
+    SQLPOINTER value,
+    SQLINTEGER buffer_length,
+    SQLINTEGER* length) {
+  dbc* conn = as<dbc>(h, dbc_handle);
+  if (conn == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (attribute == SQL_ATTR_CURRENT_CATALOG) {
+    return put_string(*conn, "mock", value, buffer_length, length);
+  }
+  SQLUINTEGER x = 0;
+  switch (attribute) {
+  case SQL_ATTR_AUTOCOMMIT:
+    x = conn->autocommit;
+    break;
+  case SQL_ATTR_TXN_ISOLATION:
+    x = conn->txn_isolation;
+    break;
+  case SQL_ATTR_CONNECTION_DEAD:
+    x = SQL_CD_FALSE;
+    break;
+  }
+  if (value != nullptr) {
+    *static_cast<SQLUINTEGER*>(value) = x;
+  }
+  if (length != nullptr) {
+    *length = sizeof(x);
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLGetInfo(
+    SQLHDBC h,
+    SQLUSMALLINT type,
+    SQLPOINTER value,
+    SQLSMALLINT buffer_length,
+    SQLSMALLINT* length) {
+  dbc* conn = as<dbc>(h, dbc_handle);
+  if (conn == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  std::string s;
+  if (info_string(type, s)) {
+    return put_string(*conn, s, value, buffer_length, length);
+  }
+  SQLUSMALLINT small;
+  if (info_usmallint(type, small)) {
+    if (value != nullptr) {
+      *static_cast<SQLUSMALLINT*>(value) = small;
+    }
+    if (length != nullptr) {
+      *length = sizeof(small);
+    }
+    return SQL_SUCCESS;
+  }
+  SQLUINTEGER x = info_uinteger(type);
+  if (value != nullptr) {
+    *static_cast<SQLUINTEGER*>(value) = x;
+  }
+  if (length != nullptr) {
+    *length = sizeof(x);
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API
+SQLEndTran(SQLSMALLINT /*type*/, SQLHANDLE h, SQLSMALLINT /*completion*/) {
+  return h == nullptr ? SQL_INVALID_HANDLE : SQL_SUCCESS;
+}
+
+// Statements -----------------------------------------------------------------
+
+SQLRETURN SQL_API SQLSetStmtAttr(
+    SQLHSTMT h, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*length*/) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  SQLULEN x = reinterpret_cast<SQLULEN>(value);
+  switch (attribute) {
+  case SQL_ATTR_ROW_ARRAY_SIZE:
+    s->row_array_size = std::max<SQLULEN>(x, 1);
+    break;
+  case SQL_ATTR_ROW_BIND_TYPE:
+    s->row_bind_type = x;
+    break;
+  case SQL_ATTR_ROWS_FETCHED_PTR:
+    s->rows_fetched = static_cast<SQLULEN*>(value);
+    break;
+  case SQL_ATTR_ROW_STATUS_PTR:
+    s->row_status = static_cast<SQLUSMALLINT*>(value);
+    break;
+  case SQL_ATTR_PARAMSET_SIZE:
+    s->paramset_size = std::max<SQLULEN>(x, 1);
+    break;
+  case SQL_ATTR_PARAMS_PROCESSED_PTR:
+    s->params_processed = static_cast<SQLULEN*>(value);
+    break;
+  case SQL_ATTR_PARAM_STATUS_PTR:
+    s->param_status = static_cast<SQLUSMALLINT*>(value);
+    break;
+  default:
+    s->attributes[attribute] = x;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLGetStmtAttr(
+    SQLHSTMT h,
+    SQLINTEGER attribute,
+    SQLPOINTER value,
+    SQLINTEGER /*buffer_length*/,
+    SQLINTEGER* length) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  SQLULEN x = 0;
+  switch (attribute) {
+  case SQL_ATTR_ROW_ARRAY_SIZE:
+    x = s->row_array_size;
+    break;
+  case SQL_ATTR_ROW_BIND_TYPE:
+    x = s->row_bind_type;
+    break;
+  case SQL_ATTR_PARAMSET_SIZE:
+    x = s->paramset_size;
+    break;
+  case SQL_ATTR_ROW_NUMBER:
+    x = s->position < 0 ? 0 : static_cast<SQLULEN>(s->position + 1);
+    break;
+  default: {
+    auto it = s->attributes.find(attribute);
+    if (it != s->attributes.end()) {
+      x = it->second;
+    }
+  }
+  }
+  if (value != nullptr) {
+    *static_cast<SQLULEN*>(value) = x;
+  }
+  if (length != nullptr) {
+    *length = sizeof(x);
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLPrepare(SQLHSTMT h, SQLCHAR* text, SQLINTEGER length) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  return prepare(*s, to_string(text, length));
+}
+
+SQLRETURN SQL_API SQLExecute(SQLHSTMT h) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  return execute(*s);
+}
+
+SQLRETURN SQL_API SQLExecDirect(SQLHSTMT h, SQLCHAR* text, SQLINTEGER length) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  SQLRETURN rc = prepare(*s, to_string(text, length));
+  if (rc != SQL_SUCCESS) {
+    return rc;
+  }
+  return execute(*s);
+}
+
+SQLRETURN SQL_API SQLNumResultCols(SQLHSTMT h, SQLSMALLINT* count) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (count != nullptr) {
+    *count = static_cast<SQLSMALLINT>(s->columns.size());
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLDescribeCol(
+    SQLHSTMT h,
+    SQLUSMALLINT number,
+    SQLCHAR* name,
+    SQLSMALLINT buffer_length,
+    SQLSMALLINT* name_length,
+    SQLSMALLINT* sql_type,
+    SQLULEN* size,
+    SQLSMALLINT* digits,
+    SQLSMALLINT* nullable) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (number < 1 || number > s->columns.size()) {
+    return fail(*s, "07009", "Invalid descriptor index");
+  }
+  column const& c = s->columns[number - 1];
+  if (sql_type != nullptr) {
+    *sql_type = c.sql_type;
+  }
+  if (size != nullptr) {
+    *size = c.size;
+  }
+  if (digits != nullptr) {
+    *digits = 0;
+  }
+  if (nullable != nullptr) {
+    *nullable = s->nulls > 0 ? SQL_NULLABLE : SQL_NO_NULLS;
+  }
+  return put_string(*s, c.name, name, buffer_length, name_length);
+}
+
+SQLRETURN SQL_API SQLBindCol(
+    SQLHSTMT h,
+    SQLUSMALLINT number,
+    SQLSMALLINT c_type,
+    SQLPOINTER target,
+    SQLLEN buffer_length,
+    SQLLEN* indicator) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (target == nullptr && indicator == nullptr) {
+    s->bindings.erase(number);
+  } else {
+    s->bindings[number] = {c_type, target, buffer_length, indicator};
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLFetchScroll(
+    SQLHSTMT h, SQLSMALLINT orientation, SQLLEN offset) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  long size = static_cast<long>(s->row_array_size);
+  long start;
+  switch (orientation) {
+  case SQL_FETCH_NEXT:
+    start = s->position < 0 ? 0 : s->position + size;
+    break;
+  case SQL_FETCH_PRIOR:
+    start = s->position >= s->rows ? s->rows - size : s->position - size;
+    break;
+  case SQL_FETCH_FIRST:
+    start = 0;
+    break;
+  case SQL_FETCH_LAST:
+    start = std::max(s->rows - size, 0L);
+    break;
+  case SQL_FETCH_ABSOLUTE:
+    start = offset > 0 ? offset - 1 : s->rows + offset;
+    break;
+  case SQL_FETCH_RELATIVE:
+    start = (s->position < 0 ? -1 : s->position) + offset;
+    break;
+  default:
+    return fail(*s, "HY106", "Fetch type out of range");
+  }
+  return fetch_rowset(*s, start);
+}
+
+SQLRETURN SQL_API SQLFetch(SQLHSTMT h) {
+  return SQLFetchScroll(h, SQL_FETCH_NEXT, 0);
+}
+
+SQLRETURN SQL_API SQLGetData(
+    SQLHSTMT h,
+    SQLUSMALLINT number,
+    SQLSMALLINT c_type,
+    SQLPOINTER target,
+    SQLLEN buffer_length,
+    SQLLEN* indicator) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (!s->open || s->position < 0 || s->position >= s->rows) {
+    return fail(*s, "24000", "Invalid cursor state");
+  }
+  if (number < 1 || number > s->columns.size()) {
+    return fail(*s, "07009", "Invalid descriptor index");
+  }
+  if (number != s->get_data_column) {
+    s->get_data_column = number;
+    s->get_data_offset = 0;
+  }
+  return put_value(
+      *s, number - 1, s->position, c_type, target, buffer_length, indicator,
+      s->get_data_offset);
+}
+
+SQLRETURN SQL_API SQLRowCount(SQLHSTMT h, SQLLEN* count) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (count != nullptr) {
+    *count = s->row_count;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLMoreResults(SQLHSTMT h) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  close_cursor(*s);
+  return SQL_NO_DATA;
+}
+
+SQLRETURN SQL_API SQLNumParams(SQLHSTMT h, SQLSMALLINT* count) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (count != nullptr) {
+    *count = s->num_params;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLDescribeParam(
+    SQLHSTMT h,
+    SQLUSMALLINT number,
+    SQLSMALLINT* sql_type,
+    SQLULEN* size,
+    SQLSMALLINT* digits,
+    SQLSMALLINT* nullable) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  if (number < 1 || number > s->num_params) {
+    return fail(*s, "07009", "Invalid descriptor index");
+  }
+  if (sql_type != nullptr) {
+    *sql_type = SQL_VARCHAR;
+  }
+  if (size != nullptr) {
+    *size = 255;
+  }
+  if (digits != nullptr) {
+    *digits = 0;
+  }
+  if (nullable != nullptr) {
+    *nullable = SQL_NULLABLE;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLBindParameter(
+    SQLHSTMT h,
+    SQLUSMALLINT number,
+    SQLSMALLINT /*io_type*/,
+    SQLSMALLINT c_type,
+    SQLSMALLINT /*sql_type*/,
+    SQLULEN /*size*/,
+    SQLSMALLINT /*digits*/,
+    SQLPOINTER value,
+    SQLLEN buffer_length,
+    SQLLEN* indicator) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  s->parameters[number] = {c_type, value, buffer_length, indicator};
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLFreeStmt(SQLHSTMT h, SQLUSMALLINT option) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  switch (option) {
+  case SQL_CLOSE:
+    close_cursor(*s);
+    break;
+  case SQL_UNBIND:
+    s->bindings.clear();
+    break;
+  case SQL_RESET_PARAMS:
+    s->parameters.clear();
+    break;
+  case SQL_DROP:
+    delete s;
+    break;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLCloseCursor(SQLHSTMT h) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  close_cursor(*s);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLCancel(SQLHSTMT h) {
+  // Nothing ever runs in the background.
+  return as<stmt>(h, stmt_handle) == nullptr ? SQL_INVALID_HANDLE : SQL_SUCCESS;
+}
+
+// Catalog --------------------------------------------------------------------
+
+SQLRETURN SQL_API SQLTables(
+    SQLHSTMT h,
+    SQLCHAR* /*catalog*/,
+    SQLSMALLINT /*catalog_length*/,
+    SQLCHAR* /*schema*/,
+    SQLSMALLINT /*schema_length*/,
+    SQLCHAR* /*table*/,
+    SQLSMALLINT /*table_length*/,
+    SQLCHAR* /*type*/,
+    SQLSMALLINT /*type_length*/) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  return empty_result(
+      *s, {"TABLE_CAT", "TABLE_SCHEM", "TABLE_NAME", "TABLE_TYPE", "REMARKS"});
+}
+
+SQLRETURN SQL_API SQLColumns(
+    SQLHSTMT h,
+    SQLCHAR* /*catalog*/,
+    SQLSMALLINT /*catalog_length*/,
+    SQLCHAR* /*schema*/,
+    SQLSMALLINT /*schema_length*/,
+    SQLCHAR* /*table*/,
+    SQLSMALLINT /*table_length*/,
+    SQLCHAR* /*column*/,
+    SQLSMALLINT /*column_length*/) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  return empty_result(
+      *s,
+      {"TABLE_CAT", "TABLE_SCHEM", "TABLE_NAME", "COLUMN_NAME", "DATA_TYPE",
+       "TYPE_NAME", "COLUMN_SIZE", "BUFFER_LENGTH", "DECIMAL_DIGITS",
+       "NUM_PREC_RADIX", "NULLABLE", "REMARKS", "COLUMN_DEF",
+       "SQL_DATA_TYPE", "SQL_DATETIME_SUB", "CHAR_OCTET_LENGTH",
+       "ORDINAL_POSITION", "IS_NULLABLE"});
+}
+
+SQLRETURN SQL_API SQLGetTypeInfo(SQLHSTMT h, SQLSMALLINT /*type*/) {
+  stmt* s = as<stmt>(h, stmt_handle);
+  if (s == nullptr) {
+    return SQL_INVALID_HANDLE;
+  }
+  return empty_result(
+      *s,
+      {"TYPE_NAME", "DATA_TYPE", "COLUMN_SIZE", "LITERAL_PREFIX",
+       "LITERAL_SUFFIX", "CREATE_PARAMS", "NULLABLE", "CASE_SENSITIVE",
+       "SEARCHABLE", "UNSIGNED_ATTRIBUTE", "FIXED_PREC_SCALE",
+       "AUTO_UNIQUE_VALUE", "LOCAL_TYPE_NAME", "MINIMUM_SCALE",
+       "MAXIMUM_SCALE", "SQL_DATA_TYPE", "SQL_DATETIME_SUB",
+       "NUM_PREC_RADIX", "INTERVAL_PRECISION"});
+}
+
+} // extern "C"
@@ -3,11 +3,13 @@
  */
 
 #include <Rcpp.h>
+#include <chrono>
 using namespace Rcpp;
 
 #include "Iconv.h"
 
-Iconv::Iconv(const std::string& from, const std::string& to) {
+Iconv::Iconv(const std::string& from, const std::string& to)
+    : ascii_compatible_(false), conversions_(0), bytes_(0), seconds_(0) {
   if (from.empty() || from == to) {
     cd_ = NULL;
   } else {
@@ -22,6 +24,23 @@ Iconv::Iconv(const std::string& from, const std::string& to) {
 
     // Allocate space in buffer
     buffer_.resize(1024);
+
+    // Most single and multi-byte code pages (latin1, CP1252, Shift-JIS,
+    // UTF-8, ...) leave ASCII untouched.  Check once, up front, so that
+    // makeSEXP() can hand ASCII values straight to R.  Encodings such as
+    // UTF-16 or EBCDIC fail the round trip and always go through iconv.
+    // The probe includes the control characters that `is_ascii()` accepts.
+    std::string ascii;
+    for (int c = 0x01; c < 0x80; ++c) {
+      ascii.push_back(static_cast<char>(c));
+    }
+    try {
+      size_t n = convert(ascii.data(), ascii.data() + ascii.size());
+      ascii_compatible_ =
+          n == ascii.size() && std::memcmp(&buffer_[0], ascii.data(), n) == 0;
+    } catch (...) {
+      ascii_compatible_ = false;
+    }
   }
 }
 
@@ -39,7 +58,8 @@ size_t Iconv::convert(const char* start, const char* end) {
   // more than 4 output bytes
   size_t max_size = n * 4;
   if (buffer_.size() < max_size)
-    buffer_.resize(max_size);
+    buffer_.resize(std::max(max_size, buffer_.size() * 2));
+  max_size = buffer_.size();
 
   char* outbuf = &buffer_[0];
   size_t inbytesleft = n, outbytesleft = max_size;
@@ -61,6 +81,23 @@ size_t Iconv::convert(const char* start, const char* end) {
   return max_size - outbytesleft;
 }
 
+size_t Iconv::convertCounted(const char* start, const char* end) {
+  bool timed = conversions_ % time_sample == 0;
+  auto started = timed ? std::chrono::steady_clock::now()
+                       : std::chrono::steady_clock::time_point();
+  size_t n = convert(start, end);
+
+  ++conversions_;
+  bytes_ += end - start;
+  if (timed) {
+    seconds_ += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - started)
+                    .count() *
+                time_sample;
+  }
+  return n;
+}
+
 int my_strnlen(const char* s, int maxlen) {
   for (int n = 0; n < maxlen; ++n) {
     if (s[n] == '\0')
@@ -82,18 +119,24 @@ SEXP safeMakeChar(const char* start, size_t n, bool hasNull) {
   return Rf_mkCharLenCE(start, m, CE_UTF8);
 }
 
-SEXP Iconv::makeSEXP(const char* start, const char* end, bool hasNull) {
+bool Iconv::needsConversion(const char* start, const char* end) const {
   if (cd_ == NULL)
+    return false;
+  return !(ascii_compatible_ && is_ascii(start, end));
+}
+
+SEXP Iconv::makeSEXP(const char* start, const char* end, bool hasNull) {
+  if (!needsConversion(start, end))
     return safeMakeChar(start, end - start, hasNull);
 
-  int n = convert(start, end);
+  int n = convertCounted(start, end);
   return safeMakeChar(&buffer_[0], n, hasNull);
 }
 
 std::string Iconv::makeString(const char* start, const char* end) {
-  if (cd_ == NULL)
+  if (!needsConversion(start, end))
     return std::string(start, end);
 
-  int n = convert(start, end);
+  int n = convertCounted(start, end);
   return std::string(&buffer_[0], n);
 }
@@ -7,10 +7,57 @@
 
 #include "R_ext/Riconv.h"
 #include <errno.h>
+#include <cstdint>
+#include <cstring>
+
+// Returns true if any byte of `chunk` is zero.
+inline bool has_zero_byte(uint64_t chunk) {
+  return ((chunk - 0x0101010101010101ULL) & ~chunk & 0x8080808080808080ULL) !=
+         0;
+}
+
+// Returns true if every byte in [start, end) is 7-bit ASCII, other than ESC,
+// SO and SI, which stateful encodings such as ISO-2022-JP use to shift into
+// multi-byte text that is all below 0x80.
+//
+// Scans eight bytes at a time; the high bit of any non-ASCII byte survives
+// the mask.  Plain C++ so it vectorises wherever the compiler is able to,
+// without tying the package to a particular instruction set.
+inline bool is_ascii(const char* start, const char* end) {
+  const uint64_t high_bits = 0x8080808080808080ULL;
+  while (end - start >= 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, start, sizeof(chunk));
+    if ((chunk & high_bits) ||
+        has_zero_byte(chunk ^ 0x1b1b1b1b1b1b1b1bULL) ||
+        has_zero_byte((chunk ^ 0x0e0e0e0e0e0e0e0eULL) & 0xfefefefefefefefeULL)) {
+      return false;
+    }
+    start += 8;
+  }
+  for (; start < end; ++start) {
+    unsigned char c = static_cast<unsigned char>(*start);
+    if ((c & 0x80) || c == 0x1b || c == 0x0e || c == 0x0f) {
+      return false;
+    }
+  }
+  return true;
+}
 
 class Iconv {
   void* cd_;
   std::string buffer_;
+  // True when the source encoding maps the 7-bit ASCII range onto itself,
+  // so pure ASCII input can skip the converter entirely.
+  bool ascii_compatible_;
+  // Values that went through the converter, their size in bytes and the
+  // time spent converting them.  Reading the clock costs about as much as
+  // converting a short string, so only one conversion in `time_sample` is
+  // timed, and its time scaled up.
+  static const size_t time_sample = 16;
+  size_t conversions_;
+  size_t bytes_;
+  double seconds_;
 
 public:
   Iconv(const std::string& from, const std::string& to = "UTF-8");
@@ -19,9 +66,18 @@ public:
   SEXP makeSEXP(const char* start, const char* end, bool hasNull = true);
   std::string makeString(const char* start, const char* end);
 
+  size_t conversions() const { return conversions_; }
+  size_t bytes() const { return bytes_; }
+  double seconds() const { return seconds_; }
+
 private:
   // Returns number of characters in buffer
   size_t convert(const char* start, const char* end);
+
+  // convert(), counted in conversions(), bytes() and seconds().
+  size_t convertCounted(const char* start, const char* end);
+
+  bool needsConversion(const char* start, const char* end) const;
 };
 
 #endif
@@ -32,8 +32,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // odbc_connect
-connection_ptr odbc_connect(std::string const& connection_string, std::string const& timezone, std::string const& timezone_out, std::string const& encoding, std::string const& name_encoding, int bigint, long timeout, Rcpp::Nullable<Rcpp::List> const& r_attributes, bool const& interruptible_execution);
-RcppExport SEXP _odbc_odbc_connect(SEXP connection_stringSEXP, SEXP timezoneSEXP, SEXP timezone_outSEXP, SEXP encodingSEXP, SEXP name_encodingSEXP, SEXP bigintSEXP, SEXP timeoutSEXP, SEXP r_attributesSEXP, SEXP interruptible_executionSEXP) {
+connection_ptr odbc_connect(std::string const& connection_string, std::string const& timezone, std::string const& timezone_out, std::string const& encoding, std::string const& name_encoding, int bigint, long timeout, Rcpp::Nullable<Rcpp::List> const& r_attributes, bool const& interruptible_execution, bool const& pool, int statement_cache, bool const& multiple_results, double catalog_cache, double max_result_bytes);
+RcppExport SEXP _odbc_odbc_connect(SEXP connection_stringSEXP, SEXP timezoneSEXP, SEXP timezone_outSEXP, SEXP encodingSEXP, SEXP name_encodingSEXP, SEXP bigintSEXP, SEXP timeoutSEXP, SEXP r_attributesSEXP, SEXP interruptible_executionSEXP, SEXP poolSEXP, SEXP statement_cacheSEXP, SEXP multiple_resultsSEXP, SEXP catalog_cacheSEXP, SEXP max_result_bytesSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -46,7 +46,102 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< long >::type timeout(timeoutSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::List> const& >::type r_attributes(r_attributesSEXP);
     Rcpp::traits::input_parameter< bool const& >::type interruptible_execution(interruptible_executionSEXP);
-    rcpp_result_gen = Rcpp::wrap(odbc_connect(connection_string, timezone, timezone_out, encoding, name_encoding, bigint, timeout, r_attributes, interruptible_execution));
+    Rcpp::traits::input_parameter< bool const& >::type pool(poolSEXP);
+    Rcpp::traits::input_parameter< int >::type statement_cache(statement_cacheSEXP);
+    Rcpp::traits::input_parameter< bool const& >::type multiple_results(multiple_resultsSEXP);
+    Rcpp::traits::input_parameter< double >::type catalog_cache(catalog_cacheSEXP);
+    Rcpp::traits::input_parameter< double >::type max_result_bytes(max_result_bytesSEXP);
+    rcpp_result_gen = Rcpp::wrap(odbc_connect(connection_string, timezone, timezone_out, encoding, name_encoding, bigint, timeout, r_attributes, interruptible_execution, pool, statement_cache, multiple_results, catalog_cache, max_result_bytes));
+    return rcpp_result_gen;
+END_RCPP
+}
+// connection_pool_configure
+void connection_pool_configure(double max_idle, double max_lifetime, int max_size);
+RcppExport SEXP _odbc_connection_pool_configure(SEXP max_idleSEXP, SEXP max_lifetimeSEXP, SEXP max_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< double >::type max_idle(max_idleSEXP);
+    Rcpp::traits::input_parameter< double >::type max_lifetime(max_lifetimeSEXP);
+    Rcpp::traits::input_parameter< int >::type max_size(max_sizeSEXP);
+    connection_pool_configure(max_idle, max_lifetime, max_size);
+    return R_NilValue;
+END_RCPP
+}
+// connection_pool_stats
+Rcpp::List connection_pool_stats();
+RcppExport SEXP _odbc_connection_pool_stats() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(connection_pool_stats());
+    return rcpp_result_gen;
+END_RCPP
+}
+// connection_pool_clear
+void connection_pool_clear();
+RcppExport SEXP _odbc_connection_pool_clear() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    connection_pool_clear();
+    return R_NilValue;
+END_RCPP
+}
+// execution_pool_shutdown
+void execution_pool_shutdown();
+RcppExport SEXP _odbc_execution_pool_shutdown() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    execution_pool_shutdown();
+    return R_NilValue;
+END_RCPP
+}
+// call_trace_start
+void call_trace_start(bool events);
+RcppExport SEXP _odbc_call_trace_start(SEXP eventsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< bool >::type events(eventsSEXP);
+    call_trace_start(events);
+    return R_NilValue;
+END_RCPP
+}
+// call_trace_stop
+void call_trace_stop();
+RcppExport SEXP _odbc_call_trace_stop() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    call_trace_stop();
+    return R_NilValue;
+END_RCPP
+}
+// call_trace_stats
+Rcpp::DataFrame call_trace_stats();
+RcppExport SEXP _odbc_call_trace_stats() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(call_trace_stats());
+    return rcpp_result_gen;
+END_RCPP
+}
+// call_trace_write
+void call_trace_write(std::string const& path);
+RcppExport SEXP _odbc_call_trace_write(SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string const& >::type path(pathSEXP);
+    call_trace_write(path);
+    return R_NilValue;
+END_RCPP
+}
+// connection_statement_cache_stats
+Rcpp::List connection_statement_cache_stats(connection_ptr const& p);
+RcppExport SEXP _odbc_connection_statement_cache_stats(SEXP pSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< connection_ptr const& >::type p(pSEXP);
+    rcpp_result_gen = Rcpp::wrap(connection_statement_cache_stats(p));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -93,6 +188,49 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// connection_catalog_cache_stats
+Rcpp::List connection_catalog_cache_stats(connection_ptr const& p);
+RcppExport SEXP _odbc_connection_catalog_cache_stats(SEXP pSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< connection_ptr const& >::type p(pSEXP);
+    rcpp_result_gen = Rcpp::wrap(connection_catalog_cache_stats(p));
+    return rcpp_result_gen;
+END_RCPP
+}
+// connection_catalog_cache_clear
+void connection_catalog_cache_clear(connection_ptr const& p);
+RcppExport SEXP _odbc_connection_catalog_cache_clear(SEXP pSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< connection_ptr const& >::type p(pSEXP);
+    connection_catalog_cache_clear(p);
+    return R_NilValue;
+END_RCPP
+}
+// connection_decode_settings
+Rcpp::List connection_decode_settings(connection_ptr const& p);
+RcppExport SEXP _odbc_connection_decode_settings(SEXP pSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< connection_ptr const& >::type p(pSEXP);
+    rcpp_result_gen = Rcpp::wrap(connection_decode_settings(p));
+    return rcpp_result_gen;
+END_RCPP
+}
+// connection_timings
+Rcpp::List connection_timings(connection_ptr const& p);
+RcppExport SEXP _odbc_connection_timings(SEXP pSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< connection_ptr const& >::type p(pSEXP);
+    rcpp_result_gen = Rcpp::wrap(connection_timings(p));
+    return rcpp_result_gen;
+END_RCPP
+}
 // connection_begin
 void connection_begin(connection_ptr const& p);
 RcppExport SEXP _odbc_connection_begin(SEXP pSEXP) {
@@ -261,18 +399,43 @@ BEGIN_RCPP
 END_RCPP
 }
 // new_result
-result_ptr new_result(connection_ptr const& p, std::string const& sql, const bool immediate);
-RcppExport SEXP _odbc_new_result(SEXP pSEXP, SEXP sqlSEXP, SEXP immediateSEXP) {
+result_ptr new_result(connection_ptr const& p, std::string const& sql, const bool immediate, const bool async, long cursor_type, long concurrency, double timeout);
+RcppExport SEXP _odbc_new_result(SEXP pSEXP, SEXP sqlSEXP, SEXP immediateSEXP, SEXP asyncSEXP, SEXP cursor_typeSEXP, SEXP concurrencySEXP, SEXP timeoutSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< connection_ptr const& >::type p(pSEXP);
     Rcpp::traits::input_parameter< std::string const& >::type sql(sqlSEXP);
     Rcpp::traits::input_parameter< const bool >::type immediate(immediateSEXP);
-    rcpp_result_gen = Rcpp::wrap(new_result(p, sql, immediate));
+    Rcpp::traits::input_parameter< const bool >::type async(asyncSEXP);
+    Rcpp::traits::input_parameter< long >::type cursor_type(cursor_typeSEXP);
+    Rcpp::traits::input_parameter< long >::type concurrency(concurrencySEXP);
+    Rcpp::traits::input_parameter< double >::type timeout(timeoutSEXP);
+    rcpp_result_gen = Rcpp::wrap(new_result(p, sql, immediate, async, cursor_type, concurrency, timeout));
+    return rcpp_result_gen;
+END_RCPP
+}
+// result_ready
+bool result_ready(result_ptr const& r);
+RcppExport SEXP _odbc_result_ready(SEXP rSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    rcpp_result_gen = Rcpp::wrap(result_ready(r));
     return rcpp_result_gen;
 END_RCPP
 }
+// result_wait
+void result_wait(result_ptr const& r);
+RcppExport SEXP _odbc_result_wait(SEXP rSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    result_wait(r);
+    return R_NilValue;
+END_RCPP
+}
 // result_fetch
 List result_fetch(result_ptr const& r, const int n_max);
 RcppExport SEXP _odbc_result_fetch(SEXP rSEXP, SEXP n_maxSEXP) {
@@ -285,6 +448,52 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// result_fetch_arrow
+void result_fetch_arrow(result_ptr const& r, SEXP stream, const int n_max, size_t batch_rows);
+RcppExport SEXP _odbc_result_fetch_arrow(SEXP rSEXP, SEXP streamSEXP, SEXP n_maxSEXP, SEXP batch_rowsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_max(n_maxSEXP);
+    Rcpp::traits::input_parameter< size_t >::type batch_rows(batch_rowsSEXP);
+    result_fetch_arrow(r, stream, n_max, batch_rows);
+    return R_NilValue;
+END_RCPP
+}
+// result_seek
+void result_seek(result_ptr const& r, double offset);
+RcppExport SEXP _odbc_result_seek(SEXP rSEXP, SEXP offsetSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    Rcpp::traits::input_parameter< double >::type offset(offsetSEXP);
+    result_seek(r, offset);
+    return R_NilValue;
+END_RCPP
+}
+// result_timings
+Rcpp::List result_timings(result_ptr const& r);
+RcppExport SEXP _odbc_result_timings(SEXP rSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    rcpp_result_gen = Rcpp::wrap(result_timings(r));
+    return rcpp_result_gen;
+END_RCPP
+}
+// result_select_columns
+void result_select_columns(result_ptr const& r, std::vector<std::string> const& columns);
+RcppExport SEXP _odbc_result_select_columns(SEXP rSEXP, SEXP columnsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    Rcpp::traits::input_parameter< std::vector<std::string> const& >::type columns(columnsSEXP);
+    result_select_columns(r, columns);
+    return R_NilValue;
+END_RCPP
+}
 // result_column_info
 Rcpp::DataFrame result_column_info(result_ptr const& r);
 RcppExport SEXP _odbc_result_column_info(SEXP rSEXP) {
@@ -308,6 +517,22 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// result_export_csv
+double result_export_csv(result_ptr const& r, std::string const& path, std::string const& delim, std::string const& na, bool header, size_t batch_rows);
+RcppExport SEXP _odbc_result_export_csv(SEXP rSEXP, SEXP pathSEXP, SEXP delimSEXP, SEXP naSEXP, SEXP headerSEXP, SEXP batch_rowsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    Rcpp::traits::input_parameter< std::string const& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< std::string const& >::type delim(delimSEXP);
+    Rcpp::traits::input_parameter< std::string const& >::type na(naSEXP);
+    Rcpp::traits::input_parameter< bool >::type header(headerSEXP);
+    Rcpp::traits::input_parameter< size_t >::type batch_rows(batch_rowsSEXP);
+    rcpp_result_gen = Rcpp::wrap(result_export_csv(r, path, delim, na, header, batch_rows));
+    return rcpp_result_gen;
+END_RCPP
+}
 // result_insert_dataframe
 void result_insert_dataframe(result_ptr const& r, DataFrame const& df, size_t batch_rows);
 RcppExport SEXP _odbc_result_insert_dataframe(SEXP rSEXP, SEXP dfSEXP, SEXP batch_rowsSEXP) {
@@ -320,6 +545,37 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// result_insert_arrow
+double result_insert_arrow(result_ptr const& r, SEXP stream, size_t batch_rows, std::string const& encoding);
+RcppExport SEXP _odbc_result_insert_arrow(SEXP rSEXP, SEXP streamSEXP, SEXP batch_rowsSEXP, SEXP encodingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type stream(streamSEXP);
+    Rcpp::traits::input_parameter< size_t >::type batch_rows(batch_rowsSEXP);
+    Rcpp::traits::input_parameter< std::string const& >::type encoding(encodingSEXP);
+    rcpp_result_gen = Rcpp::wrap(result_insert_arrow(r, stream, batch_rows, encoding));
+    return rcpp_result_gen;
+END_RCPP
+}
+// result_import_csv
+double result_import_csv(result_ptr const& r, std::string const& path, std::string const& delim, std::string const& na, bool header, size_t batch_rows, std::string const& encoding);
+RcppExport SEXP _odbc_result_import_csv(SEXP rSEXP, SEXP pathSEXP, SEXP delimSEXP, SEXP naSEXP, SEXP headerSEXP, SEXP batch_rowsSEXP, SEXP encodingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< result_ptr const& >::type r(rSEXP);
+    Rcpp::traits::input_parameter< std::string const& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< std::string const& >::type delim(delimSEXP);
+    Rcpp::traits::input_parameter< std::string const& >::type na(naSEXP);
+    Rcpp::traits::input_parameter< bool >::type header(headerSEXP);
+    Rcpp::traits::input_parameter< size_t >::type batch_rows(batch_rowsSEXP);
+    Rcpp::traits::input_parameter< std::string const& >::type encoding(encodingSEXP);
+    rcpp_result_gen = Rcpp::wrap(result_import_csv(r, path, delim, na, header, batch_rows, encoding));
+    return rcpp_result_gen;
+END_RCPP
+}
 // result_describe_parameters
 void result_describe_parameters(result_ptr const& r, DataFrame const& df);
 RcppExport SEXP _odbc_result_describe_parameters(SEXP rSEXP, SEXP dfSEXP) {
@@ -353,6 +609,26 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cursor_types
+Rcpp::IntegerVector cursor_types();
+RcppExport SEXP _odbc_cursor_types() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(cursor_types());
+    return rcpp_result_gen;
+END_RCPP
+}
+// cursor_concurrencies
+Rcpp::IntegerVector cursor_concurrencies();
+RcppExport SEXP _odbc_cursor_concurrencies() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(cursor_concurrencies());
+    return rcpp_result_gen;
+END_RCPP
+}
 // column_types
 void column_types(DataFrame const& df);
 RcppExport SEXP _odbc_column_types(SEXP dfSEXP) {
@@ -367,11 +643,24 @@ END_RCPP
 static const R_CallMethodDef CallEntries[] = {
     {"_odbc_list_drivers_", (DL_FUNC) &_odbc_list_drivers_, 0},
     {"_odbc_list_data_sources_", (DL_FUNC) &_odbc_list_data_sources_, 0},
-    {"_odbc_odbc_connect", (DL_FUNC) &_odbc_odbc_connect, 9},
+    {"_odbc_odbc_connect", (DL_FUNC) &_odbc_odbc_connect, 14},
+    {"_odbc_connection_pool_configure", (DL_FUNC) &_odbc_connection_pool_configure, 3},
+    {"_odbc_connection_pool_stats", (DL_FUNC) &_odbc_connection_pool_stats, 0},
+    {"_odbc_connection_pool_clear", (DL_FUNC) &_odbc_connection_pool_clear, 0},
+    {"_odbc_execution_pool_shutdown", (DL_FUNC) &_odbc_execution_pool_shutdown, 0},
+    {"_odbc_call_trace_start", (DL_FUNC) &_odbc_call_trace_start, 1},
+    {"_odbc_call_trace_stop", (DL_FUNC) &_odbc_call_trace_stop, 0},
+    {"_odbc_call_trace_stats", (DL_FUNC) &_odbc_call_trace_stats, 0},
+    {"_odbc_call_trace_write", (DL_FUNC) &_odbc_call_trace_write, 1},
+    {"_odbc_connection_statement_cache_stats", (DL_FUNC) &_odbc_connection_statement_cache_stats, 1},
     {"_odbc_has_result", (DL_FUNC) &_odbc_has_result, 1},
     {"_odbc_connection_info", (DL_FUNC) &_odbc_connection_info, 1},
     {"_odbc_connection_quote", (DL_FUNC) &_odbc_connection_quote, 1},
     {"_odbc_connection_release", (DL_FUNC) &_odbc_connection_release, 1},
+    {"_odbc_connection_catalog_cache_stats", (DL_FUNC) &_odbc_connection_catalog_cache_stats, 1},
+    {"_odbc_connection_catalog_cache_clear", (DL_FUNC) &_odbc_connection_catalog_cache_clear, 1},
+    {"_odbc_connection_decode_settings", (DL_FUNC) &_odbc_connection_decode_settings, 1},
+    {"_odbc_connection_timings", (DL_FUNC) &_odbc_connection_timings, 1},
     {"_odbc_connection_begin", (DL_FUNC) &_odbc_connection_begin, 1},
     {"_odbc_connection_commit", (DL_FUNC) &_odbc_connection_commit, 1},
     {"_odbc_connection_rollback", (DL_FUNC) &_odbc_connection_rollback, 1},
@@ -387,14 +676,25 @@ static const R_CallMethodDef CallEntries[] = {
     {"_odbc_result_release", (DL_FUNC) &_odbc_result_release, 1},
     {"_odbc_result_active", (DL_FUNC) &_odbc_result_active, 1},
     {"_odbc_result_completed", (DL_FUNC) &_odbc_result_completed, 1},
-    {"_odbc_new_result", (DL_FUNC) &_odbc_new_result, 3},
+    {"_odbc_new_result", (DL_FUNC) &_odbc_new_result, 7},
+    {"_odbc_result_ready", (DL_FUNC) &_odbc_result_ready, 1},
+    {"_odbc_result_wait", (DL_FUNC) &_odbc_result_wait, 1},
     {"_odbc_result_fetch", (DL_FUNC) &_odbc_result_fetch, 2},
+    {"_odbc_result_fetch_arrow", (DL_FUNC) &_odbc_result_fetch_arrow, 4},
+    {"_odbc_result_seek", (DL_FUNC) &_odbc_result_seek, 2},
+    {"_odbc_result_timings", (DL_FUNC) &_odbc_result_timings, 1},
+    {"_odbc_result_select_columns", (DL_FUNC) &_odbc_result_select_columns, 2},
     {"_odbc_result_column_info", (DL_FUNC) &_odbc_result_column_info, 1},
     {"_odbc_result_bind", (DL_FUNC) &_odbc_result_bind, 3},
+    {"_odbc_result_export_csv", (DL_FUNC) &_odbc_result_export_csv, 6},
     {"_odbc_result_insert_dataframe", (DL_FUNC) &_odbc_result_insert_dataframe, 3},
+    {"_odbc_result_insert_arrow", (DL_FUNC) &_odbc_result_insert_arrow, 4},
+    {"_odbc_result_import_csv", (DL_FUNC) &_odbc_result_import_csv, 7},
     {"_odbc_result_describe_parameters", (DL_FUNC) &_odbc_result_describe_parameters, 2},
     {"_odbc_result_rows_affected", (DL_FUNC) &_odbc_result_rows_affected, 1},
     {"_odbc_result_row_count", (DL_FUNC) &_odbc_result_row_count, 1},
+    {"_odbc_cursor_types", (DL_FUNC) &_odbc_cursor_types, 0},
+    {"_odbc_cursor_concurrencies", (DL_FUNC) &_odbc_cursor_concurrencies, 0},
     {"_odbc_column_types", (DL_FUNC) &_odbc_column_types, 1},
     {NULL, NULL, 0}
 };
@@ -0,0 +1,306 @@
+#include "arrow_export.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+namespace odbc {
+
+namespace {
+
+// Owns the buffers and children of an exported `ArrowArray`.
+struct array_data {
+  std::vector<uint8_t> validity;
+  std::vector<uint8_t> data;
+  std::vector<int32_t> offsets;
+  const void* buffers[3] = {nullptr, nullptr, nullptr};
+  std::vector<ArrowArray*> children;
+};
+
+void release_array(ArrowArray* array) {
+  auto data = static_cast<array_data*>(array->private_data);
+  for (auto child : data->children) {
+    // Consumers may have moved children out, releasing them on their own.
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+    delete child;
+  }
+  delete data;
+  array->release = nullptr;
+}
+
+// Owns the strings and children of an exported `ArrowSchema`.
+struct schema_data {
+  std::string format;
+  std::string name;
+  std::vector<ArrowSchema*> children;
+};
+
+void release_schema(ArrowSchema* schema) {
+  auto data = static_cast<schema_data*>(schema->private_data);
+  for (auto child : data->children) {
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+    delete child;
+  }
+  delete data;
+  schema->release = nullptr;
+}
+
+void init_schema(ArrowSchema* out, schema_data* data, int64_t flags) {
+  out->format = data->format.c_str();
+  out->name = data->name.c_str();
+  out->metadata = nullptr;
+  out->flags = flags;
+  out->n_children = static_cast<int64_t>(data->children.size());
+  out->children = data->children.empty() ? nullptr : data->children.data();
+  out->dictionary = nullptr;
+  out->release = release_schema;
+  out->private_data = data;
+}
+
+std::string arrow_format(arrow_field const& field) {
+  switch (field.type) {
+  case arrow_bool:
+    return "b";
+  case arrow_int32:
+    return "i";
+  case arrow_int64:
+    return "l";
+  case arrow_double:
+    return "g";
+  case arrow_date32:
+    return "tdD";
+  case arrow_time64:
+    return "ttu";
+  case arrow_timestamp:
+    return "tsu:" + field.timezone;
+  case arrow_utf8:
+    return "u";
+  case arrow_binary:
+    return "z";
+  }
+  return "";
+}
+
+} // namespace
+
+arrow_column_builder::arrow_column_builder(arrow_type type)
+    : type_(type), length_(0), null_count_(0), offsets_(1, 0) {}
+
+void arrow_column_builder::set_valid(bool valid) {
+  if (length_ % 8 == 0) {
+    validity_.push_back(0);
+  }
+  if (valid) {
+    validity_.back() |= static_cast<uint8_t>(1 << (length_ % 8));
+  } else {
+    ++null_count_;
+  }
+}
+
+template <typename T> void arrow_column_builder::append_fixed(T value) {
+  size_t size = data_.size();
+  data_.resize(size + sizeof(T));
+  std::memcpy(data_.data() + size, &value, sizeof(T));
+}
+
+void arrow_column_builder::append_null() {
+  set_valid(false);
+  switch (type_) {
+  case arrow_bool:
+    if (length_ % 8 == 0) {
+      data_.push_back(0);
+    }
+    break;
+  case arrow_int32:
+  case arrow_date32:
+    data_.resize(data_.size() + sizeof(int32_t));
+    break;
+  case arrow_int64:
+  case arrow_time64:
+  case arrow_timestamp:
+  case arrow_double:
+    data_.resize(data_.size() + sizeof(int64_t));
+    break;
+  case arrow_utf8:
+  case arrow_binary:
+    offsets_.push_back(offsets_.back());
+    break;
+  }
+  ++length_;
+}
+
+void arrow_column_builder::append_bool(bool value) {
+  set_valid(true);
+  if (length_ % 8 == 0) {
+    data_.push_back(0);
+  }
+  if (value) {
+    data_.back() |= static_cast<uint8_t>(1 << (length_ % 8));
+  }
+  ++length_;
+}
+
+void arrow_column_builder::append_int32(int32_t value) {
+  set_valid(true);
+  append_fixed(value);
+  ++length_;
+}
+
+void arrow_column_builder::append_int64(int64_t value) {
+  set_valid(true);
+  append_fixed(value);
+  ++length_;
+}
+
+void arrow_column_builder::append_double(double value) {
+  set_valid(true);
+  append_fixed(value);
+  ++length_;
+}
+
+void arrow_column_builder::append_bytes(const char* data, size_t size) {
+  set_valid(true);
+  data_.insert(data_.end(), data, data + size);
+  offsets_.push_back(static_cast<int32_t>(data_.size()));
+  ++length_;
+}
+
+void arrow_column_builder::finish(ArrowArray* out) {
+  auto data = new array_data();
+  data->validity.swap(validity_);
+  data->data.swap(data_);
+  data->offsets.swap(offsets_);
+  // Consumers may not accept null data buffers, even when empty.
+  data->data.reserve(1);
+
+  // The next batch is likely to be about as large as this one.
+  validity_.reserve(data->validity.size());
+  data_.reserve(data->data.size());
+  offsets_.reserve(data->offsets.size());
+  offsets_.push_back(0);
+
+  // The validity bitmap may be left out when there are no nulls.
+  data->buffers[0] = null_count_ > 0 ? data->validity.data() : nullptr;
+  bool variable = type_ == arrow_utf8 || type_ == arrow_binary;
+  if (variable) {
+    data->buffers[1] = data->offsets.data();
+    data->buffers[2] = data->data.data();
+  } else {
+    data->buffers[1] = data->data.data();
+  }
+
+  out->length = length_;
+  out->null_count = null_count_;
+  out->offset = 0;
+  out->n_buffers = variable ? 3 : 2;
+  out->n_children = 0;
+  out->buffers = data->buffers;
+  out->children = nullptr;
+  out->dictionary = nullptr;
+  out->release = release_array;
+  out->private_data = data;
+
+  length_ = 0;
+  null_count_ = 0;
+}
+
+arrow_batches::arrow_batches(std::vector<arrow_field> fields)
+    : fields_(std::move(fields)) {}
+
+arrow_batches::~arrow_batches() {
+  for (auto& batch : batches_) {
+    if (batch.release != nullptr) {
+      batch.release(&batch);
+    }
+  }
+}
+
+void arrow_batches::push_back(
+    std::vector<arrow_column_builder>& columns, int64_t rows) {
+  auto data = new array_data();
+  for (auto& column : columns) {
+    auto child = new ArrowArray;
+    column.finish(child);
+    data->children.push_back(child);
+  }
+
+  ArrowArray batch;
+  batch.length = rows;
+  batch.null_count = 0;
+  batch.offset = 0;
+  batch.n_buffers = 1;
+  batch.n_children = static_cast<int64_t>(data->children.size());
+  batch.buffers = data->buffers;
+  batch.children = data->children.empty() ? nullptr : data->children.data();
+  batch.dictionary = nullptr;
+  batch.release = release_array;
+  batch.private_data = data;
+  batches_.push_back(batch);
+}
+
+bool arrow_batches::pop_front(ArrowArray* out) {
+  if (batches_.empty()) {
+    return false;
+  }
+  *out = batches_.front();
+  batches_.pop_front();
+  return true;
+}
+
+void arrow_batches::export_schema(ArrowSchema* out) const {
+  auto data = new schema_data();
+  data->format = "+s";
+  for (auto const& field : fields_) {
+    auto child_data = new schema_data();
+    child_data->format = arrow_format(field);
+    child_data->name = field.name;
+    auto child = new ArrowSchema;
+    init_schema(child, child_data, field.nullable ? ARROW_FLAG_NULLABLE : 0);
+    data->children.push_back(child);
+  }
+  init_schema(out, data, 0);
+}
+
+void arrow_batches::export_stream(
+    arrow_batches* batches, ArrowArrayStream* out) {
+  out->get_schema = get_schema;
+  out->get_next = get_next;
+  out->get_last_error = get_last_error;
+  out->release = release;
+  out->private_data = batches;
+}
+
+int arrow_batches::get_schema(ArrowArrayStream* stream, ArrowSchema* out) {
+  try {
+    static_cast<arrow_batches*>(stream->private_data)->export_schema(out);
+  } catch (const std::bad_alloc&) {
+    return ENOMEM;
+  }
+  return 0;
+}
+
+int arrow_batches::get_next(ArrowArrayStream* stream, ArrowArray* out) {
+  auto self = static_cast<arrow_batches*>(stream->private_data);
+  if (!self->pop_front(out)) {
+    // A released array marks the end of the stream.
+    out->release = nullptr;
+  }
+  return 0;
+}
+
+const char* arrow_batches::get_last_error(ArrowArrayStream* /* stream */) {
+  // Every row is fetched before the stream is exported, so reading it
+  // cannot fail.
+  return nullptr;
+}
+
+void arrow_batches::release(ArrowArrayStream* stream) {
+  delete static_cast<arrow_batches*>(stream->private_data);
+  stream->release = nullptr;
+}
+
+} // namespace odbc
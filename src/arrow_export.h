@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// The Arrow C data and stream interfaces, as specified in
+// https://arrow.apache.org/docs/format/CDataInterface.html and
+// https://arrow.apache.org/docs/format/CStreamInterface.html.  The
+// definitions are meant to be copied verbatim; the guards let them coexist
+// with copies from other libraries.
+extern "C" {
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  // Array type description
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+struct ArrowArray {
+  // Array data description
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+  // Callbacks providing stream functionality
+  int (*get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+  int (*get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+  const char* (*get_last_error)(struct ArrowArrayStream*);
+
+  // Release callback
+  void (*release)(struct ArrowArrayStream*);
+
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+#endif // ARROW_C_STREAM_INTERFACE
+}
+
+namespace odbc {
+
+/// \brief Arrow types that result columns are fetched as.
+enum arrow_type {
+  arrow_bool,
+  arrow_int32,
+  arrow_int64,
+  arrow_double,
+  arrow_date32,     // Days since the epoch
+  arrow_time64,     // Microseconds since midnight
+  arrow_timestamp,  // Microseconds since the epoch
+  arrow_utf8,
+  arrow_binary,
+};
+
+struct arrow_field {
+  std::string name; // UTF-8
+  arrow_type type;
+  bool nullable;
+  // Time zone of `arrow_timestamp` fields.
+  std::string timezone;
+};
+
+/// \brief Accumulates the values of one column of a record batch in
+/// Arrow's columnar layout.
+///
+/// Values are appended row by row; `finish()` hands the buffers over to an
+/// `ArrowArray` without copying them and starts an empty column.
+class arrow_column_builder {
+public:
+  explicit arrow_column_builder(arrow_type type);
+
+  void append_null();
+  void append_bool(bool value);
+  void append_int32(int32_t value);
+  void append_int64(int64_t value);
+  void append_double(double value);
+  // For `arrow_utf8` and `arrow_binary`.
+  void append_bytes(const char* data, size_t size);
+
+  int64_t length() const { return length_; }
+  // Size of the variable-length data, which 32 bit offsets limit to 2GB
+  // per batch.
+  size_t data_bytes() const { return type_ >= arrow_utf8 ? data_.size() : 0; }
+
+  void finish(ArrowArray* out);
+
+private:
+  arrow_type type_;
+  int64_t length_;
+  int64_t null_count_;
+  std::vector<uint8_t> validity_;
+  std::vector<uint8_t> data_;
+  std::vector<int32_t> offsets_;
+
+  void set_valid(bool valid);
+  template <typename T> void append_fixed(T value);
+};
+
+/// \brief Record batches waiting to be read from an `ArrowArrayStream`.
+///
+/// Owns its batches until they are moved out by `get_next`, and releases
+/// whatever is left when destroyed.
+class arrow_batches {
+public:
+  explicit arrow_batches(std::vector<arrow_field> fields);
+  ~arrow_batches();
+
+  std::vector<arrow_field> const& fields() const { return fields_; }
+
+  /// \brief Add a struct array of the finished `columns` as the next batch.
+  void push_back(std::vector<arrow_column_builder>& columns, int64_t rows);
+
+  size_t size() const { return batches_.size(); }
+
+  /// \brief Move the first batch into `out`.
+  ///
+  /// \return `false`, leaving `out` untouched, if there are no batches.
+  bool pop_front(ArrowArray* out);
+
+  /// \brief Export the batches as `out`, which takes ownership of them.
+  static void export_stream(arrow_batches* batches, ArrowArrayStream* out);
+
+private:
+  std::vector<arrow_field> fields_;
+  std::deque<ArrowArray> batches_;
+
+  void export_schema(ArrowSchema* out) const;
+
+  static int get_schema(ArrowArrayStream* stream, ArrowSchema* out);
+  static int get_next(ArrowArrayStream* stream, ArrowArray* out);
+  static const char* get_last_error(ArrowArrayStream* stream);
+  static void release(ArrowArrayStream* stream);
+};
+
+} // namespace odbc
@@ -0,0 +1,48 @@
+#include "arrow_import.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace odbc {
+
+arrow_stream_reader::arrow_stream_reader(ArrowArrayStream* stream)
+    : stream_(stream) {
+  std::memset(&schema_, 0, sizeof(schema_));
+  std::memset(&batch_, 0, sizeof(batch_));
+  check(stream_->get_schema(stream_, &schema_), "schema");
+}
+
+arrow_stream_reader::~arrow_stream_reader() {
+  if (batch_.release != nullptr) {
+    batch_.release(&batch_);
+  }
+  if (schema_.release != nullptr) {
+    schema_.release(&schema_);
+  }
+}
+
+bool arrow_stream_reader::next() {
+  if (batch_.release != nullptr) {
+    batch_.release(&batch_);
+  }
+  check(stream_->get_next(stream_, &batch_), "record batch");
+  return batch_.release != nullptr;
+}
+
+void arrow_stream_reader::check(int code, const char* what) {
+  if (code == 0) {
+    return;
+  }
+  std::string message = std::string("Failed to read Arrow ") + what;
+  const char* error = stream_->get_last_error(stream_);
+  if (error != nullptr) {
+    message += ": ";
+    message += error;
+  } else {
+    message += " (" + std::string(std::strerror(code)) + ")";
+  }
+  throw std::runtime_error(message);
+}
+
+} // namespace odbc
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "arrow_export.h"
+
+#include <cstdint>
+
+namespace odbc {
+
+/// \brief Reads the record batches of an `ArrowArrayStream`.
+///
+/// The stream itself stays owned by the caller; the schema and the current
+/// batch are released by the reader.
+class arrow_stream_reader {
+public:
+  /// \throws std::runtime_error If the stream's schema cannot be read.
+  explicit arrow_stream_reader(ArrowArrayStream* stream);
+  ~arrow_stream_reader();
+
+  arrow_stream_reader(arrow_stream_reader const&) = delete;
+  arrow_stream_reader& operator=(arrow_stream_reader const&) = delete;
+
+  ArrowSchema const& schema() const { return schema_; }
+
+  /// \brief Read the next batch, releasing the current one.
+  ///
+  /// \return `false` at the end of the stream.
+  /// \throws std::runtime_error If the producer fails.
+  bool next();
+
+  ArrowArray const& batch() const { return batch_; }
+
+private:
+  ArrowArrayStream* stream_;
+  ArrowSchema schema_;
+  ArrowArray batch_;
+
+  void check(int code, const char* what);
+};
+
+/// \brief Whether element `i` of `array`, not counting its offset, is
+/// valid (not null).
+inline bool arrow_is_valid(ArrowArray const& array, int64_t i) {
+  auto validity = static_cast<const uint8_t*>(array.buffers[0]);
+  if (validity == nullptr) {
+    return true;
+  }
+  i += array.offset;
+  return (validity[i / 8] >> (i % 8)) & 1;
+}
+
+} // namespace odbc
@@ -0,0 +1,136 @@
+#include "call_trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace odbc {
+
+namespace {
+
+double seconds_between(
+    nanodbc::call_tracer::clock::time_point start,
+    nanodbc::call_tracer::clock::time_point end) {
+  return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+call_trace& call_trace::instance() {
+  // Intentionally leaked: execution threads may still be calling the driver
+  // while static destructors run.
+  static call_trace* trace = new call_trace();
+  return *trace;
+}
+
+call_trace::call_trace() : record_events_(false) {}
+
+void call_trace::start(bool events) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    functions_.clear();
+    events_.clear();
+    threads_.clear();
+    record_events_ = events;
+    started_ = clock::now();
+  }
+  nanodbc::set_call_tracer(this);
+}
+
+void call_trace::stop() { nanodbc::set_call_tracer(nullptr); }
+
+void call_trace::on_call(
+    const char* function, clock::time_point start, clock::time_point end) {
+  double seconds = seconds_between(start, end);
+  // Bucket `k` holds latencies in [2^(k / 4), 2^((k + 1) / 4)) nanoseconds.
+  double k = std::floor(4 * std::log2(std::max(seconds * 1e9, 1.0)));
+  size_t bucket = std::min(static_cast<size_t>(k), buckets - 1);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& h = functions_[function];
+  ++h.calls;
+  h.seconds += seconds;
+  h.max = std::max(h.max, seconds);
+  ++h.counts[bucket];
+
+  if (record_events_ && events_.size() < max_events) {
+    auto thread = threads_.emplace(std::this_thread::get_id(), threads_.size());
+    events_.push_back({function, start, end, thread.first->second});
+  }
+}
+
+void call_trace::on_bytes(const char* function, size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  functions_[function].bytes += bytes;
+}
+
+double call_trace::histogram::quantile(double q) const {
+  size_t rank = static_cast<size_t>(std::ceil(q * calls));
+  size_t seen = 0;
+  for (size_t k = 0; k < buckets; ++k) {
+    seen += counts[k];
+    if (seen >= rank && counts[k] > 0) {
+      // The middle of the bucket, in seconds.
+      return std::min(std::exp2((k + 0.5) / 4) / 1e9, max);
+    }
+  }
+  return max;
+}
+
+std::vector<call_trace::function_stats> call_trace::get_stats() const {
+  std::vector<function_stats> out;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto const& f : functions_) {
+    auto const& h = f.second;
+    out.push_back(
+        {f.first,
+         h.calls,
+         h.seconds,
+         h.quantile(0.5),
+         h.quantile(0.99),
+         h.max,
+         h.bytes});
+  }
+  std::sort(
+      out.begin(),
+      out.end(),
+      [](function_stats const& x, function_stats const& y) {
+        return x.seconds > y.seconds;
+      });
+  return out;
+}
+
+void call_trace::write_events(std::string const& path) const {
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    throw std::runtime_error(
+        "Can't open '" + path + "' for writing: " + std::strerror(errno));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::fputs("{\"traceEvents\":[", file);
+    for (size_t i = 0; i < events_.size(); ++i) {
+      auto const& e = events_[i];
+      // Complete events, with times in microseconds since tracing started.
+      std::fprintf(
+          file,
+          "%s\n{\"name\":\"%s\",\"cat\":\"odbc\",\"ph\":\"X\",\"ts\":%.3f,"
+          "\"dur\":%.3f,\"pid\":1,\"tid\":%zu}",
+          i == 0 ? "" : ",",
+          e.function,
+          seconds_between(started_, e.start) * 1e6,
+          seconds_between(e.start, e.end) * 1e6,
+          e.thread + 1);
+    }
+    std::fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+  }
+  bool failed = std::ferror(file) != 0;
+  if (std::fclose(file) != 0 || failed) {
+    throw std::runtime_error(
+        "Failed to write '" + path + "': " + std::strerror(errno));
+  }
+}
+
+} // namespace odbc
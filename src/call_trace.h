@@ -0,0 +1,102 @@
+#pragma once
+
+#include "nanodbc.h"
+#include <array>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace odbc {
+
+/// \brief Process wide record of the ODBC calls made by nanodbc.
+///
+/// Installed as nanodbc's `call_tracer` while tracing is on.  For every ODBC
+/// function it counts the calls, their total time and the bytes of column
+/// data they returned, and keeps a histogram of their latencies with four
+/// buckets per power of two, so that percentiles are accurate to about 10%.
+/// Optionally every call is recorded as well, up to `max_events`, to be
+/// written as a Chrome trace.
+///
+/// Calls are recorded from execution threads as well as the main [R]
+/// thread, so all members are guarded by a mutex.
+class call_trace : public nanodbc::call_tracer {
+public:
+  struct function_stats {
+    std::string function;
+    size_t calls;
+    double seconds;
+    double p50;
+    double p99;
+    double max;
+    size_t bytes;
+  };
+
+  static call_trace& instance();
+
+  /// \brief Forget what was recorded and start tracing.
+  ///
+  /// \param events Whether to record every call for `write_events`.
+  void start(bool events);
+
+  /// \brief Stop tracing, keeping what was recorded.
+  void stop();
+
+  /// \brief Statistics per ODBC function, slowest in total first.
+  std::vector<function_stats> get_stats() const;
+
+  /// \brief Write the recorded calls as Chrome trace event JSON, as read by
+  /// Perfetto and `chrome://tracing`.
+  ///
+  /// \throws std::runtime_error If `path` cannot be written.
+  void write_events(std::string const& path) const;
+
+  void on_call(
+      const char* function,
+      clock::time_point start,
+      clock::time_point end) override;
+  void on_bytes(const char* function, size_t bytes) override;
+
+private:
+  call_trace();
+
+  static const size_t buckets = 4 * 48;
+  static const size_t max_events = 1000000;
+
+  struct histogram {
+    size_t calls = 0;
+    double seconds = 0;
+    double max = 0;
+    size_t bytes = 0;
+    std::array<size_t, buckets> counts{};
+
+    // Upper bound of the latency of the `q`th quantile of calls.
+    double quantile(double q) const;
+  };
+
+  struct event {
+    const char* function;
+    clock::time_point start;
+    clock::time_point end;
+    size_t thread;
+  };
+
+  // Function names are the string literals passed by nanodbc.
+  struct name_less {
+    bool operator()(const char* x, const char* y) const {
+      return std::strcmp(x, y) < 0;
+    }
+  };
+
+  mutable std::mutex mutex_;
+  std::map<const char*, histogram, name_less> functions_;
+  bool record_events_;
+  std::vector<event> events_;
+  // Small ids for the threads calls were made from.
+  std::map<std::thread::id, size_t> threads_;
+  clock::time_point started_;
+};
+
+} // namespace odbc
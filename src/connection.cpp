@@ -1,5 +1,7 @@
 #include "Rcpp.h"
+#include "call_trace.h"
 #include "condition.h"
+#include "execution_pool.h"
 #include "nanodbc.h"
 #include "odbc_types.h"
 #include "r_types.h"
@@ -55,7 +57,12 @@ connection_ptr odbc_connect(
     int bigint = 0,
     long timeout = 0,
     Rcpp::Nullable<Rcpp::List> const& r_attributes = R_NilValue,
-    bool const& interruptible_execution = true) {
+    bool const& interruptible_execution = true,
+    bool const& pool = false,
+    int statement_cache = 0,
+    bool const& multiple_results = false,
+    double catalog_cache = 0,
+    double max_result_bytes = 0) {
   return connection_ptr(
       new std::shared_ptr<odbc_connection>(new odbc_connection(
           connection_string,
@@ -66,7 +73,84 @@ connection_ptr odbc_connect(
           static_cast<bigint_map_t>(bigint),
           timeout,
           r_attributes,
-          interruptible_execution)));
+          interruptible_execution,
+          pool,
+          statement_cache,
+          multiple_results,
+          catalog_cache,
+          max_result_bytes)));
+}
+
+// [[Rcpp::export]]
+void connection_pool_configure(
+    double max_idle, double max_lifetime, int max_size) {
+  connection_pool::instance().configure(max_idle, max_lifetime, max_size);
+}
+
+// [[Rcpp::export]]
+Rcpp::List connection_pool_stats() {
+  auto stats = connection_pool::instance().get_stats();
+  return Rcpp::List::create(
+      Rcpp::_["hits"] = static_cast<double>(stats.hits),
+      Rcpp::_["misses"] = static_cast<double>(stats.misses),
+      Rcpp::_["evictions"] = static_cast<double>(stats.evictions),
+      Rcpp::_["idle"] = static_cast<double>(stats.idle));
+}
+
+// [[Rcpp::export]]
+void connection_pool_clear() { connection_pool::instance().clear(); }
+
+// [[Rcpp::export]]
+void execution_pool_shutdown() { execution_pool::instance().shutdown(); }
+
+// [[Rcpp::export]]
+void call_trace_start(bool events = false) {
+  call_trace::instance().start(events);
+}
+
+// [[Rcpp::export]]
+void call_trace_stop() { call_trace::instance().stop(); }
+
+// [[Rcpp::export]]
+Rcpp::DataFrame call_trace_stats() {
+  auto stats = call_trace::instance().get_stats();
+  size_t n = stats.size();
+  Rcpp::CharacterVector name(n);
+  Rcpp::NumericVector calls(n), seconds(n), p50(n), p99(n), max(n), bytes(n);
+  for (size_t i = 0; i < n; ++i) {
+    name[i] = stats[i].function;
+    calls[i] = static_cast<double>(stats[i].calls);
+    seconds[i] = stats[i].seconds;
+    p50[i] = stats[i].p50;
+    p99[i] = stats[i].p99;
+    max[i] = stats[i].max;
+    bytes[i] = static_cast<double>(stats[i].bytes);
+  }
+  return Rcpp::DataFrame::create(
+      Rcpp::_["name"] = name,
+      Rcpp::_["calls"] = calls,
+      Rcpp::_["seconds"] = seconds,
+      Rcpp::_["p50"] = p50,
+      Rcpp::_["p99"] = p99,
+      Rcpp::_["max"] = max,
+      Rcpp::_["bytes"] = bytes,
+      Rcpp::_["stringsAsFactors"] = false);
+}
+
+// [[Rcpp::export]]
+void call_trace_write(std::string const& path) {
+  call_trace::instance().write_events(path);
+}
+
+// [[Rcpp::export]]
+Rcpp::List connection_statement_cache_stats(connection_ptr const& p) {
+  auto stats = (*p)->get_statement_cache_stats();
+  return Rcpp::List::create(
+      Rcpp::_["hits"] = static_cast<double>(stats.hits),
+      Rcpp::_["misses"] = static_cast<double>(stats.misses),
+      Rcpp::_["evictions"] = static_cast<double>(stats.evictions),
+      Rcpp::_["size"] = static_cast<double>(stats.size),
+      Rcpp::_["capacity"] = static_cast<double>(stats.capacity));
 }
 
 std::string get_info_or_empty(connection_ptr const& p, short type) {
@@ -134,6 +218,31 @@ void connection_release(connection_ptr p) {
   p.release();
 }
 
+// [[Rcpp::export]]
+Rcpp::List connection_catalog_cache_stats(connection_ptr const& p) {
+  auto stats = (*p)->get_catalog_cache_stats();
+  return Rcpp::List::create(
+      Rcpp::_["hits"] = static_cast<double>(stats.hits),
+      Rcpp::_["misses"] = static_cast<double>(stats.misses),
+      Rcpp::_["size"] = static_cast<double>(stats.size),
+      Rcpp::_["ttl"] = stats.ttl);
+}
+
+// [[Rcpp::export]]
+void connection_catalog_cache_clear(connection_ptr const& p) {
+  (*p)->clear_catalog_cache();
+}
+
+// [[Rcpp::export]]
+Rcpp::List connection_decode_settings(connection_ptr const& p) {
+  return (*p)->decode_settings();
+}
+
+// [[Rcpp::export]]
+Rcpp::List connection_timings(connection_ptr const& p) {
+  return (*p)->get_result_stats().to_list();
+}
+
 // [[Rcpp::export]]
 void connection_begin(connection_ptr const& p) { (*p)->begin(); }
 
@@ -146,6 +255,47 @@ void connection_rollback(connection_ptr const& p) { (*p)->rollback(); }
 // [[Rcpp::export]]
 bool connection_valid(connection_ptr const& p) { return p.get() != nullptr; }
 
+// A column of a catalog listing.  Values are written straight into an R
+// vector, grown geometrically and truncated once all rows are read, rather
+// than kept in a std::vector until the end and copied.  Values are still
+// read as a std::string each through nanodbc::catalog's accessors, and
+// growing the vector copies it.
+template <int RTYPE>
+class catalog_column {
+public:
+  catalog_column() : x_(Rcpp::no_init(64)), n_(0) {}
+
+  template <typename T>
+  void push_back(T const& value) {
+    if (n_ == x_.size()) {
+      x_ = Rf_xlengthgets(x_, 2 * n_);
+    }
+    x_[n_++] = value;
+  }
+
+  SEXP get() {
+    if (n_ != x_.size()) {
+      x_ = Rf_xlengthgets(x_, n_);
+    }
+    return x_;
+  }
+
+private:
+  Rcpp::Vector<RTYPE> x_;
+  R_xlen_t n_;
+};
+
+// Key for the catalog cache: the catalog function and its arguments, with
+// NULL kept distinct from any string.
+std::string catalog_key(
+    std::string const& function, std::initializer_list<SEXP> args) {
+  std::string key = function;
+  for (SEXP arg : args) {
+    key += arg == R_NilValue ? "\n-" : "\n+" + Rcpp::as<std::string>(arg);
+  }
+  return key;
+}
+
 // [[Rcpp::export]]
 Rcpp::DataFrame connection_sql_tables(
     connection_ptr const& p,
@@ -153,6 +303,13 @@ Rcpp::DataFrame connection_sql_tables(
     SEXP schema_name = R_NilValue,
     SEXP table_name = R_NilValue,
     SEXP table_type = R_NilValue) {
+  std::string key = catalog_key(
+      "SQLTables", {catalog_name, schema_name, table_name, table_type});
+  SEXP cached = (*p)->cached_catalog(key);
+  if (cached != R_NilValue) {
+    return cached;
+  }
+
   auto c = nanodbc::catalog(*(*p)->connection());
   nanodbc::catalog::tables tables = nanodbc::catalog::tables(c.find_tables(
       table_name == R_NilValue ? nullptr : Rcpp::as<const char*>(table_name),
@@ -160,11 +317,11 @@ Rcpp::DataFrame connection_sql_tables(
       schema_name == R_NilValue ? nullptr : Rcpp::as<const char*>(schema_name),
       catalog_name == R_NilValue ? nullptr
                                  : Rcpp::as<const char*>(catalog_name)));
-  std::vector<std::string> names;
-  std::vector<std::string> types;
-  std::vector<std::string> schemas;
-  std::vector<std::string> remarks;
-  std::vector<std::string> catalog;
+  catalog_column<STRSXP> names;
+  catalog_column<STRSXP> types;
+  catalog_column<STRSXP> schemas;
+  catalog_column<STRSXP> remarks;
+  catalog_column<STRSXP> catalog;
 
   while (tables.next()) {
     names.push_back(tables.table_name());
@@ -173,13 +330,15 @@ Rcpp::DataFrame connection_sql_tables(
     remarks.push_back(tables.table_remarks());
     catalog.push_back(tables.table_catalog());
   }
-  return Rcpp::DataFrame::create(
-      Rcpp::_["table_catalog"] = catalog,
-      Rcpp::_["table_schema"] = schemas,
-      Rcpp::_["table_name"] = names,
-      Rcpp::_["table_type"] = types,
-      Rcpp::_["table_remarks"] = remarks,
+  Rcpp::DataFrame out = Rcpp::DataFrame::create(
+      Rcpp::_["table_catalog"] = catalog.get(),
+      Rcpp::_["table_schema"] = schemas.get(),
+      Rcpp::_["table_name"] = names.get(),
+      Rcpp::_["table_type"] = types.get(),
+      Rcpp::_["table_remarks"] = remarks.get(),
       Rcpp::_["stringsAsFactors"] = false);
+  (*p)->cache_catalog(key, out);
+  return out;
 }
 
 // [[Rcpp::export]]
@@ -232,6 +391,13 @@ Rcpp::DataFrame connection_sql_columns(
     SEXP catalog_name = R_NilValue,
     SEXP schema_name = R_NilValue,
     SEXP table_name = R_NilValue) {
+  std::string key = catalog_key(
+      "SQLColumns", {column_name, catalog_name, schema_name, table_name});
+  SEXP cached = (*p)->cached_catalog(key);
+  if (cached != R_NilValue) {
+    return cached;
+  }
+
   auto c = nanodbc::catalog(*(*p)->connection());
   auto tables = c.find_columns(
       column_name == R_NilValue ? nullptr : Rcpp::as<const char*>(column_name),
@@ -240,23 +406,23 @@ Rcpp::DataFrame connection_sql_columns(
       catalog_name == R_NilValue ? nullptr
                                  : Rcpp::as<const char*>(catalog_name));
 
-  std::vector<std::string> column_names;
-  std::vector<std::string> table_names;
-  std::vector<std::string> schema_names;
-  std::vector<std::string> catalog_names;
-  std::vector<short> data_type;
-  std::vector<std::string> type_name;
-  std::vector<long> column_size;
-  std::vector<long> buffer_length;
-  std::vector<short> decimal_digits;
-  std::vector<short> numeric_precision_radix;
-  std::vector<bool> nullable;
-  std::vector<std::string> remarks;
-  std::vector<std::string> column_default;
-  std::vector<short> sql_data_type;
-  std::vector<short> sql_datetime_subtype;
-  std::vector<long> char_octet_length;
-  std::vector<long> ordinal_position;
+  catalog_column<STRSXP> column_names;
+  catalog_column<STRSXP> table_names;
+  catalog_column<STRSXP> schema_names;
+  catalog_column<STRSXP> catalog_names;
+  catalog_column<INTSXP> data_type;
+  catalog_column<STRSXP> type_name;
+  catalog_column<REALSXP> column_size;
+  catalog_column<REALSXP> buffer_length;
+  catalog_column<INTSXP> decimal_digits;
+  catalog_column<INTSXP> numeric_precision_radix;
+  catalog_column<LGLSXP> nullable;
+  catalog_column<STRSXP> remarks;
+  catalog_column<STRSXP> column_default;
+  catalog_column<INTSXP> sql_data_type;
+  catalog_column<INTSXP> sql_datetime_subtype;
+  catalog_column<REALSXP> char_octet_length;
+  catalog_column<REALSXP> ordinal_position;
 
   while (tables.next()) {
     column_names.push_back(tables.column_name());
@@ -269,7 +435,7 @@ Rcpp::DataFrame connection_sql_columns(
     buffer_length.push_back(tables.buffer_length());
     decimal_digits.push_back(tables.decimal_digits());
     numeric_precision_radix.push_back(tables.numeric_precision_radix());
-    nullable.push_back(tables.nullable());
+    nullable.push_back(tables.nullable() != 0);
     remarks.push_back(tables.remarks());
     column_default.push_back(tables.column_default());
     sql_data_type.push_back(tables.sql_data_type());
@@ -277,25 +443,27 @@ Rcpp::DataFrame connection_sql_columns(
     char_octet_length.push_back(tables.char_octet_length());
     ordinal_position.push_back(tables.ordinal_position());
   }
-  return Rcpp::DataFrame::create(
-      Rcpp::_["name"] = column_names,
-      Rcpp::_["field.type"] = type_name,
-      Rcpp::_["table_name"] = table_names,
-      Rcpp::_["schema_name"] = schema_names,
-      Rcpp::_["catalog_name"] = catalog_names,
-      Rcpp::_["data_type"] = data_type,
-      Rcpp::_["column_size"] = column_size,
-      Rcpp::_["buffer_length"] = buffer_length,
-      Rcpp::_["decimal_digits"] = decimal_digits,
-      Rcpp::_["numeric_precision_radix"] = numeric_precision_radix,
-      Rcpp::_["remarks"] = remarks,
-      Rcpp::_["column_default"] = column_default,
-      Rcpp::_["sql_data_type"] = sql_data_type,
-      Rcpp::_["sql_datetime_subtype"] = sql_datetime_subtype,
-      Rcpp::_["char_octet_length"] = char_octet_length,
-      Rcpp::_["ordinal_position"] = ordinal_position,
-      Rcpp::_["nullable"] = nullable,
+  Rcpp::DataFrame out = Rcpp::DataFrame::create(
+      Rcpp::_["name"] = column_names.get(),
+      Rcpp::_["field.type"] = type_name.get(),
+      Rcpp::_["table_name"] = table_names.get(),
+      Rcpp::_["schema_name"] = schema_names.get(),
+      Rcpp::_["catalog_name"] = catalog_names.get(),
+      Rcpp::_["data_type"] = data_type.get(),
+      Rcpp::_["column_size"] = column_size.get(),
+      Rcpp::_["buffer_length"] = buffer_length.get(),
+      Rcpp::_["decimal_digits"] = decimal_digits.get(),
+      Rcpp::_["numeric_precision_radix"] = numeric_precision_radix.get(),
+      Rcpp::_["remarks"] = remarks.get(),
+      Rcpp::_["column_default"] = column_default.get(),
+      Rcpp::_["sql_data_type"] = sql_data_type.get(),
+      Rcpp::_["sql_datetime_subtype"] = sql_datetime_subtype.get(),
+      Rcpp::_["char_octet_length"] = char_octet_length.get(),
+      Rcpp::_["ordinal_position"] = ordinal_position.get(),
+      Rcpp::_["nullable"] = nullable.get(),
       Rcpp::_["stringsAsFactors"] = false);
+  (*p)->cache_catalog(key, out);
+  return out;
 }
 
 // [[Rcpp::export]]
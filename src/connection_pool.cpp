@@ -0,0 +1,258 @@
+#include "connection_pool.h"
+#include "sql_types.h"
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+#ifndef SQL_ATTR_CONNECTION_DEAD
+#define SQL_ATTR_CONNECTION_DEAD 1209
+#endif
+#ifndef SQL_CD_TRUE
+#define SQL_CD_TRUE 1L
+#endif
+
+namespace odbc {
+
+namespace {
+
+std::string trim(std::string const& x) {
+  size_t start = 0, end = x.size();
+  while (start < end && std::isspace(static_cast<unsigned char>(x[start]))) {
+    ++start;
+  }
+  while (end > start && std::isspace(static_cast<unsigned char>(x[end - 1]))) {
+    --end;
+  }
+  return x.substr(start, end - start);
+}
+
+// Split a connection string into `keyword=value` pairs.  Semicolons inside
+// braced values (`{...}`, with `}}` as an escaped brace) do not separate
+// pairs.
+std::vector<std::pair<std::string, std::string>>
+parse_connection_string(std::string const& x) {
+  std::vector<std::string> pieces;
+  std::string current;
+  bool braced = false;
+  for (size_t i = 0; i < x.size(); ++i) {
+    char ch = x[i];
+    if (braced) {
+      if (ch == '}') {
+        if (i + 1 < x.size() && x[i + 1] == '}') {
+          current += "}}";
+          ++i;
+          continue;
+        }
+        braced = false;
+      }
+      current += ch;
+      continue;
+    }
+    if (ch == '{') {
+      braced = true;
+    }
+    if (ch == ';') {
+      pieces.push_back(current);
+      current.clear();
+      continue;
+    }
+    current += ch;
+  }
+  pieces.push_back(current);
+
+  std::vector<std::pair<std::string, std::string>> pairs;
+  for (auto const& piece : pieces) {
+    std::string item = trim(piece);
+    if (item.empty()) {
+      continue;
+    }
+    size_t eq = item.find('=');
+    std::string keyword = trim(item.substr(0, eq));
+    std::string value = eq == std::string::npos ? "" : trim(item.substr(eq + 1));
+    std::transform(keyword.begin(), keyword.end(), keyword.begin(), [](char c) {
+      return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    });
+    pairs.push_back({keyword, value});
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+} // namespace
+
+connection_pool& connection_pool::instance() {
+  // Intentionally leaked: disconnecting from static destructors may run
+  // after the driver manager has been unloaded.
+  static connection_pool* pool = new connection_pool();
+  return *pool;
+}
+
+connection_pool::connection_pool()
+    : max_idle_(60),
+      max_lifetime_(3600),
+      max_size_(4),
+      hits_(0),
+      misses_(0),
+      evictions_(0) {}
+
+std::string connection_pool::key(
+    std::string const& connection_string,
+    long const& timeout,
+    Rcpp::Nullable<Rcpp::List> const& r_attributes) {
+  std::string out;
+  for (auto const& pair : parse_connection_string(connection_string)) {
+    out += pair.first + "=" + pair.second + ";";
+  }
+  out += "\ntimeout=" + std::to_string(timeout);
+
+  // Only string valued attributes are passed on to the driver
+  // (see `utils::prepare_connection_attributes`).
+  if (r_attributes.isNotNull()) {
+    Rcpp::List attributes(r_attributes);
+    if (!Rf_isNull(attributes.names())) {
+      Rcpp::CharacterVector names = attributes.names();
+      std::vector<std::pair<std::string, std::string>> pairs;
+      for (R_xlen_t i = 0; i < attributes.size(); ++i) {
+        SEXP value = attributes[i];
+        if (TYPEOF(value) == STRSXP && Rf_xlength(value) == 1) {
+          pairs.push_back(
+              {Rcpp::as<std::string>(names[i]), Rcpp::as<std::string>(value)});
+        }
+      }
+      std::sort(pairs.begin(), pairs.end());
+      for (auto const& pair : pairs) {
+        out += "\n" + pair.first + "=" + pair.second;
+      }
+    }
+  }
+  return out;
+}
+
+bool connection_pool::expired(entry const& e, clock::time_point now) const {
+  return now - e.released > max_idle_ || now - e.created > max_lifetime_;
+}
+
+bool connection_pool::alive(entry const& e) const {
+  if (!e.connection->connected()) {
+    return false;
+  }
+  SQLUINTEGER dead = 0;
+  RETCODE rc = SQLGetConnectAttr(
+      e.connection->native_dbc_handle(),
+      SQL_ATTR_CONNECTION_DEAD,
+      &dead,
+      SQL_IS_UINTEGER,
+      nullptr);
+  // Drivers that do not implement the attribute are given the benefit of
+  // the doubt.
+  return !SQL_SUCCEEDED(rc) || dead != SQL_CD_TRUE;
+}
+
+bool connection_pool::acquire(std::string const& key, entry& out) {
+  bool found = false;
+  for (;;) {
+    // Take a candidate out under the lock, but probe it with the driver,
+    // which may go to the server, after releasing it.
+    entry candidate;
+    std::vector<entry> closing;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = idle_.find(key);
+      if (it != idle_.end()) {
+        auto& entries = it->second;
+        auto now = clock::now();
+        while (!entries.empty()) {
+          entry e = std::move(entries.back());
+          entries.pop_back();
+          if (expired(e, now)) {
+            ++evictions_;
+            closing.push_back(std::move(e));
+            continue;
+          }
+          candidate = std::move(e);
+          break;
+        }
+        if (entries.empty()) {
+          idle_.erase(it);
+        }
+      }
+    }
+    // `closing` goes out of scope at the end of each iteration,
+    // disconnecting evicted connections outside of the lock.
+    if (!candidate.connection) {
+      break;
+    }
+    if (alive(candidate)) {
+      out = std::move(candidate);
+      found = true;
+      break;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++evictions_;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (found) {
+    ++hits_;
+  } else {
+    ++misses_;
+  }
+  return found;
+}
+
+void connection_pool::release(std::string const& key, entry e) {
+  std::vector<entry> closing;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = clock::now();
+    e.released = now;
+    auto& entries = idle_[key];
+    if (now - e.created > max_lifetime_ || entries.size() >= max_size_) {
+      ++evictions_;
+      closing.push_back(std::move(e));
+    } else {
+      entries.push_back(std::move(e));
+    }
+    // Opportunistically drop connections that have been idle for too long.
+    for (auto it = idle_.begin(); it != idle_.end();) {
+      auto& idle = it->second;
+      auto expired_begin = std::stable_partition(
+          idle.begin(), idle.end(), [this, now](entry const& x) {
+            return !expired(x, now);
+          });
+      for (auto x = expired_begin; x != idle.end(); ++x) {
+        ++evictions_;
+        closing.push_back(std::move(*x));
+      }
+      idle.erase(expired_begin, idle.end());
+      it = idle.empty() ? idle_.erase(it) : std::next(it);
+    }
+  }
+}
+
+void connection_pool::configure(
+    double max_idle, double max_lifetime, size_t max_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_idle_ = std::chrono::duration<double>(max_idle);
+  max_lifetime_ = std::chrono::duration<double>(max_lifetime);
+  max_size_ = max_size;
+}
+
+void connection_pool::clear() {
+  std::map<std::string, std::vector<entry>> closing;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing.swap(idle_);
+  }
+}
+
+connection_pool::stats connection_pool::get_stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t idle = 0;
+  for (auto const& entries : idle_) {
+    idle += entries.second.size();
+  }
+  return {hits_, misses_, evictions_, idle};
+}
+
+} // namespace odbc
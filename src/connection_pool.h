@@ -0,0 +1,92 @@
+#pragma once
+
+#include "nanodbc.h"
+#include <Rcpp.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace odbc {
+
+/// \brief Process wide pool of idle ODBC connections.
+///
+/// Connections opened with `dbConnect(pool = TRUE)` are handed back here
+/// when their `odbc_connection` is destroyed, and lent out again to later
+/// connections with the same key (see `connection_pool::key`).  Before a
+/// connection is lent out it is checked with `SQL_ATTR_CONNECTION_DEAD`;
+/// connections that have been idle for longer than `max_idle`, or open for
+/// longer than `max_lifetime`, are closed instead.
+///
+/// All members are called from the main [R] thread; the mutex only guards
+/// against connections being released from an execution thread.
+class connection_pool {
+public:
+  typedef std::chrono::steady_clock clock;
+
+  struct entry {
+    std::shared_ptr<nanodbc::connection> connection;
+    clock::time_point created;
+    clock::time_point released;
+  };
+
+  struct stats {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t idle;
+  };
+
+  static connection_pool& instance();
+
+  /// \brief Key identifying interchangeable connections.
+  ///
+  /// The connection string is normalised: keywords are lower-cased,
+  /// whitespace around keywords and values is dropped and the pairs are
+  /// sorted, so that equivalent strings built in a different order share
+  /// connections.  Values are compared as is.  String valued connection
+  /// attributes and the login timeout are part of the key.
+  static std::string key(
+      std::string const& connection_string,
+      long const& timeout,
+      Rcpp::Nullable<Rcpp::List> const& r_attributes);
+
+  /// \brief Borrow an idle, live connection for `key`.
+  ///
+  /// Counts a hit or a miss.  On a miss `out` is left untouched and the
+  /// caller is expected to open a new connection.
+  bool acquire(std::string const& key, entry& out);
+
+  /// \brief Return a connection to the pool.
+  ///
+  /// The connection is closed instead if it has outlived `max_lifetime`, or
+  /// if `max_size` connections are already idle for `key`.
+  void release(std::string const& key, entry e);
+
+  void configure(double max_idle, double max_lifetime, size_t max_size);
+
+  /// \brief Close all idle connections.
+  void clear();
+
+  stats get_stats() const;
+
+private:
+  connection_pool();
+
+  bool expired(entry const& e, clock::time_point now) const;
+  bool alive(entry const& e) const;
+
+  // Idle connections per key, most recently released last.
+  std::map<std::string, std::vector<entry>> idle_;
+  std::chrono::duration<double> max_idle_;
+  std::chrono::duration<double> max_lifetime_;
+  size_t max_size_;
+  size_t hits_;
+  size_t misses_;
+  size_t evictions_;
+  mutable std::mutex mutex_;
+};
+
+} // namespace odbc
@@ -0,0 +1,131 @@
+#include "csv_reader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace odbc {
+
+csv_reader::csv_reader(
+    std::string const& path, char delimiter, size_t columns)
+    : path_(path),
+      delimiter_(delimiter),
+      columns_(columns),
+      file_(std::fopen(path.c_str(), "rb")),
+      buffer_(1 << 20),
+      pos_(0),
+      size_(0),
+      line_(1) {
+  if (file_ == nullptr) {
+    throw std::runtime_error(
+        "Can't open '" + path + "' for reading: " + std::strerror(errno));
+  }
+}
+
+csv_reader::~csv_reader() { std::fclose(file_); }
+
+bool csv_reader::fill() {
+  size_ = std::fread(buffer_.data(), 1, buffer_.size(), file_);
+  pos_ = 0;
+  if (size_ == 0 && std::ferror(file_)) {
+    throw std::runtime_error(
+        "Failed to read '" + path_ + "': " + std::strerror(errno));
+  }
+  return size_ > 0;
+}
+
+int csv_reader::peek() {
+  if (pos_ == size_ && !fill()) {
+    return EOF;
+  }
+  return static_cast<unsigned char>(buffer_[pos_]);
+}
+
+int csv_reader::next() {
+  int c = peek();
+  if (c != EOF) {
+    ++pos_;
+  }
+  return c;
+}
+
+bool csv_reader::read(size_t n, csv_chunk& out) {
+  const int delimiter = static_cast<unsigned char>(delimiter_);
+  out.clear();
+  out.columns = columns_;
+  while (out.rows() < n) {
+    int c = peek();
+    if (c == EOF) {
+      break;
+    }
+    // Blank lines
+    if (c == '\n' || c == '\r') {
+      next();
+      if (c == '\r' && peek() == '\n') {
+        next();
+      }
+      ++line_;
+      continue;
+    }
+
+    size_t row_line = line_;
+    size_t fields = 0;
+    while (true) {
+      bool quoted = peek() == '"';
+      if (quoted) {
+        next();
+        while (true) {
+          c = next();
+          if (c == EOF) {
+            throw std::runtime_error(
+                "Unterminated quoted field in line " +
+                std::to_string(row_line) + " of '" + path_ + "'.");
+          }
+          if (c == '"') {
+            if (peek() != '"') {
+              break;
+            }
+            next();
+          } else if (c == '\n') {
+            ++line_;
+          }
+          out.data += static_cast<char>(c);
+        }
+      }
+      // Unquoted fields, and anything between a closing quote and the
+      // delimiter.
+      while (true) {
+        c = peek();
+        if (c == EOF || c == delimiter || c == '\n' || c == '\r') {
+          break;
+        }
+        out.data += static_cast<char>(next());
+      }
+      out.ends.push_back(out.data.size());
+      out.quoted.push_back(quoted);
+      ++fields;
+
+      c = next();
+      if (c == delimiter) {
+        continue;
+      }
+      if (c == '\r' && peek() == '\n') {
+        next();
+      }
+      if (c != EOF) {
+        ++line_;
+      }
+      break;
+    }
+    if (fields != columns_) {
+      throw std::runtime_error(
+          "Line " + std::to_string(row_line) + " of '" + path_ + "' has " +
+          std::to_string(fields) + " fields, expected " +
+          std::to_string(columns_) + ".");
+    }
+    out.lines.push_back(row_line);
+  }
+  return out.rows() > 0;
+}
+
+} // namespace odbc
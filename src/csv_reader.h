@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace odbc {
+
+/// \brief Rows of a delimited file, with unescaped field values packed
+/// into one buffer.
+struct csv_chunk {
+  std::string data;
+  // Field `k` of the chunk, row-major, spans `[ends[k - 1], ends[k])`.
+  std::vector<size_t> ends;
+  // Whether each field was quoted; quoted fields are never null.
+  std::vector<uint8_t> quoted;
+  // Line of the file each row starts on, for error messages.
+  std::vector<size_t> lines;
+  size_t columns;
+
+  size_t rows() const { return lines.size(); }
+  const char* begin(size_t row, size_t column) const {
+    size_t k = row * columns + column;
+    return data.data() + (k == 0 ? 0 : ends[k - 1]);
+  }
+  const char* end(size_t row, size_t column) const {
+    return data.data() + ends[row * columns + column];
+  }
+  bool is_quoted(size_t row, size_t column) const {
+    return quoted[row * columns + column] != 0;
+  }
+  void clear() {
+    data.clear();
+    ends.clear();
+    quoted.clear();
+    lines.clear();
+  }
+};
+
+/// \brief Parses a delimited file a chunk of rows at a time.
+///
+/// Fields may be quoted with `"`, with quotes inside them doubled; quoted
+/// fields may span lines.  Both `\n` and `\r\n` end rows, and blank lines
+/// are skipped.
+class csv_reader {
+public:
+  /// \throws std::runtime_error If `path` cannot be opened.
+  csv_reader(std::string const& path, char delimiter, size_t columns);
+  ~csv_reader();
+
+  csv_reader(csv_reader const&) = delete;
+  csv_reader& operator=(csv_reader const&) = delete;
+
+  /// \brief Parse up to `n` rows into `out`, replacing its contents.
+  ///
+  /// \return `false` if there were no rows left.
+  /// \throws std::runtime_error If a row does not have `columns` fields,
+  /// or reading the file fails.
+  bool read(size_t n, csv_chunk& out);
+
+private:
+  std::string path_;
+  char delimiter_;
+  size_t columns_;
+  std::FILE* file_;
+  std::vector<char> buffer_;
+  size_t pos_;
+  size_t size_;
+  size_t line_;
+
+  // Next character of the file, or EOF.
+  int next();
+  int peek();
+  bool fill();
+};
+
+} // namespace odbc
@@ -0,0 +1,318 @@
+#include "csv_writer.h"
+#include "arrow_import.h"
+#include "execution_pool.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace odbc {
+
+namespace {
+
+// Civil date of `days` since 1970-01-01, from Howard Hinnant's
+// `civil_from_days`.
+void civil_from_days(int64_t days, int64_t& y, unsigned& m, unsigned& d) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(days - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+void append_date(int64_t days, std::string& out) {
+  int64_t y;
+  unsigned m, d;
+  civil_from_days(days, y, m, d);
+  char buf[32];
+  int n = std::snprintf(
+      buf, sizeof(buf), "%04lld-%02u-%02u", static_cast<long long>(y), m, d);
+  out.append(buf, n);
+}
+
+// `micros` since midnight, with fractional seconds only when non-zero.
+void append_time(int64_t micros, std::string& out) {
+  int64_t seconds = micros / 1000000;
+  char buf[32];
+  int n = std::snprintf(
+      buf,
+      sizeof(buf),
+      "%02d:%02d:%02d",
+      static_cast<int>(seconds / 3600),
+      static_cast<int>(seconds / 60 % 60),
+      static_cast<int>(seconds % 60));
+  out.append(buf, n);
+  if (micros % 1000000 != 0) {
+    n = std::snprintf(
+        buf, sizeof(buf), ".%06d", static_cast<int>(micros % 1000000));
+    out.append(buf, n);
+  }
+}
+
+int64_t floor_div(int64_t x, int64_t y) {
+  int64_t q = x / y;
+  return (x % y != 0 && (x < 0) != (y < 0)) ? q - 1 : q;
+}
+
+} // namespace
+
+csv_writer::csv_writer(
+    std::string const& path,
+    std::vector<arrow_field> const& fields,
+    csv_options const& options)
+    : path_(path),
+      fields_(fields),
+      options_(options),
+      file_(std::fopen(path.c_str(), "wb")),
+      done_(false) {
+  if (file_ == nullptr) {
+    throw std::runtime_error(
+        "Can't open '" + path + "' for writing: " + std::strerror(errno));
+  }
+  std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+  if (options_.header) {
+    std::string out;
+    format_header(out);
+    put(out);
+  }
+  thread_ = execution_pool::instance().submit([this]() { run(); });
+}
+
+csv_writer::~csv_writer() {
+  if (file_ == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& batch : queue_) {
+      batch.release(&batch);
+    }
+    queue_.clear();
+  }
+  stop();
+  std::fclose(file_);
+  std::remove(path_.c_str());
+}
+
+void csv_writer::write(ArrowArray* batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() {
+    return queue_.size() < max_queued_ || error_ != nullptr;
+  });
+  if (error_ != nullptr) {
+    batch->release(batch);
+    std::rethrow_exception(error_);
+  }
+  queue_.push_back(*batch);
+  batch->release = nullptr;
+  lock.unlock();
+  cv_.notify_all();
+}
+
+void csv_writer::close() {
+  stop();
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+  int closed = std::fclose(file_);
+  file_ = nullptr;
+  if (closed != 0) {
+    throw std::runtime_error(
+        "Failed to write '" + path_ + "': " + std::strerror(errno));
+  }
+}
+
+void csv_writer::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.valid()) {
+    thread_.get();
+  }
+  // Left over when the writer failed.
+  for (auto& batch : queue_) {
+    batch.release(&batch);
+  }
+  queue_.clear();
+}
+
+void csv_writer::run() {
+  std::string out;
+  while (true) {
+    ArrowArray batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return !queue_.empty() || done_; });
+      if (queue_.empty()) {
+        return;
+      }
+      batch = queue_.front();
+      queue_.pop_front();
+    }
+    cv_.notify_all();
+
+    try {
+      out.clear();
+      format_batch(batch, out);
+      batch.release(&batch);
+      put(out);
+    } catch (...) {
+      if (batch.release != nullptr) {
+        batch.release(&batch);
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = std::current_exception();
+      cv_.notify_all();
+      return;
+    }
+  }
+}
+
+void csv_writer::put(std::string const& out) {
+  if (std::fwrite(out.data(), 1, out.size(), file_) != out.size()) {
+    throw std::runtime_error(
+        "Failed to write '" + path_ + "': " + std::strerror(errno));
+  }
+}
+
+void csv_writer::format_header(std::string& out) const {
+  for (size_t j = 0; j < fields_.size(); ++j) {
+    if (j > 0) {
+      out += options_.delimiter;
+    }
+    format_bytes(fields_[j].name.data(), fields_[j].name.size(), out);
+  }
+  out += '\n';
+}
+
+void csv_writer::format_batch(
+    ArrowArray const& batch, std::string& out) const {
+  for (int64_t i = 0; i < batch.length; ++i) {
+    int64_t row = batch.offset + i;
+    for (size_t j = 0; j < fields_.size(); ++j) {
+      if (j > 0) {
+        out += options_.delimiter;
+      }
+      auto const& array = *batch.children[j];
+      if (!arrow_is_valid(array, row)) {
+        out += options_.na;
+      } else {
+        format_value(fields_[j], array, row, out);
+      }
+    }
+    out += '\n';
+  }
+}
+
+void csv_writer::format_value(
+    arrow_field const& field,
+    ArrowArray const& array,
+    int64_t i,
+    std::string& out) const {
+  i += array.offset;
+  const void* values = array.buffers[1];
+  char buf[64];
+  int n = 0;
+  switch (field.type) {
+  case arrow_bool: {
+    auto bits = static_cast<const uint8_t*>(values);
+    out += (bits[i / 8] >> (i % 8)) & 1 ? "TRUE" : "FALSE";
+    break;
+  }
+  case arrow_int32:
+    n = std::snprintf(
+        buf, sizeof(buf), "%d", static_cast<const int32_t*>(values)[i]);
+    out.append(buf, n);
+    break;
+  case arrow_int64:
+    n = std::snprintf(
+        buf,
+        sizeof(buf),
+        "%lld",
+        static_cast<long long>(static_cast<const int64_t*>(values)[i]));
+    out.append(buf, n);
+    break;
+  case arrow_double: {
+    double value = static_cast<const double*>(values)[i];
+    if (std::isnan(value)) {
+      out += "NaN";
+    } else if (std::isinf(value)) {
+      out += value > 0 ? "Inf" : "-Inf";
+    } else {
+      // 17 significant digits always read back as the same double; 15 are
+      // shorter, and enough for most values.
+      n = std::snprintf(buf, sizeof(buf), "%.15g", value);
+      if (std::strtod(buf, nullptr) != value) {
+        n = std::snprintf(buf, sizeof(buf), "%.17g", value);
+      }
+      out.append(buf, n);
+    }
+    break;
+  }
+  case arrow_date32:
+    append_date(static_cast<const int32_t*>(values)[i], out);
+    break;
+  case arrow_time64:
+    append_time(static_cast<const int64_t*>(values)[i], out);
+    break;
+  case arrow_timestamp: {
+    int64_t micros = static_cast<const int64_t*>(values)[i];
+    const int64_t micros_per_day = 86400000000LL;
+    int64_t days = floor_div(micros, micros_per_day);
+    append_date(days, out);
+    out += 'T';
+    append_time(micros - days * micros_per_day, out);
+    out += 'Z';
+    break;
+  }
+  case arrow_utf8: {
+    auto offsets = static_cast<const int32_t*>(values);
+    auto data = static_cast<const char*>(array.buffers[2]);
+    format_bytes(data + offsets[i], offsets[i + 1] - offsets[i], out);
+    break;
+  }
+  case arrow_binary: {
+    static const char hex[] = "0123456789abcdef";
+    auto offsets = static_cast<const int32_t*>(values);
+    auto data = static_cast<const uint8_t*>(array.buffers[2]);
+    for (int32_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+      out += hex[data[k] >> 4];
+      out += hex[data[k] & 0xf];
+    }
+    break;
+  }
+  }
+}
+
+void csv_writer::format_bytes(
+    const char* data, size_t size, std::string& out) const {
+  // Quote values that would otherwise be read back as nulls, too.
+  bool quote = size == options_.na.size() &&
+               std::memcmp(data, options_.na.data(), size) == 0;
+  for (size_t k = 0; k < size && !quote; ++k) {
+    char c = data[k];
+    quote = c == options_.delimiter || c == '"' || c == '\n' || c == '\r';
+  }
+  if (!quote) {
+    out.append(data, size);
+    return;
+  }
+  out += '"';
+  for (size_t k = 0; k < size; ++k) {
+    if (data[k] == '"') {
+      out += '"';
+    }
+    out += data[k];
+  }
+  out += '"';
+}
+
+} // namespace odbc
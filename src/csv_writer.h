@@ -0,0 +1,84 @@
+#pragma once
+
+#include "arrow_export.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace odbc {
+
+struct csv_options {
+  char delimiter;
+  // Written for nulls.
+  std::string na;
+  bool header;
+};
+
+/// \brief Writes Arrow record batches to a CSV file on a pool thread.
+///
+/// Batches are formatted and written while the next ones are fetched.  At
+/// most a couple of batches are queued, so that memory use does not grow
+/// with the size of the result when the disk is slower than the database.
+///
+/// Dates are written as `YYYY-MM-DD`, timestamps in ISO 8601 in UTC, and
+/// binary values as hexadecimal.  Values are quoted only when they contain
+/// the delimiter, quotes or line breaks.
+class csv_writer {
+public:
+  /// \throws std::runtime_error If `path` cannot be opened for writing.
+  csv_writer(
+      std::string const& path,
+      std::vector<arrow_field> const& fields,
+      csv_options const& options);
+
+  /// \brief Stops writing if `close()` was not called, removing the
+  /// incomplete file.
+  ~csv_writer();
+
+  csv_writer(csv_writer const&) = delete;
+  csv_writer& operator=(csv_writer const&) = delete;
+
+  /// \brief Queue `batch` for writing, taking ownership of it.
+  ///
+  /// Blocks while the queue is full.  Rethrows errors from the writer
+  /// thread.
+  void write(ArrowArray* batch);
+
+  /// \brief Write the remaining batches and close the file.
+  void close();
+
+private:
+  std::string path_;
+  std::vector<arrow_field> fields_;
+  csv_options options_;
+  std::FILE* file_;
+
+  std::deque<ArrowArray> queue_;
+  bool done_;
+  std::exception_ptr error_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::future<void> thread_;
+
+  static const size_t max_queued_ = 2;
+
+  void run();
+  void stop();
+  void put(std::string const& out);
+  void format_header(std::string& out) const;
+  void format_batch(ArrowArray const& batch, std::string& out) const;
+  void format_value(
+      arrow_field const& field,
+      ArrowArray const& array,
+      int64_t i,
+      std::string& out) const;
+  void format_bytes(const char* data, size_t size, std::string& out) const;
+};
+
+} // namespace odbc
@@ -0,0 +1,113 @@
+#include "execution_pool.h"
+#include <thread>
+#include <utility>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <signal.h>
+#endif
+
+namespace odbc {
+
+execution_pool& execution_pool::instance() {
+  // Intentionally leaked: the threads are joined by `shutdown()` when the
+  // package is unloaded, not by static destructors.
+  static execution_pool* pool = new execution_pool();
+  return *pool;
+}
+
+execution_pool::execution_pool()
+    : stopping_(false), idle_(0), max_idle_(60) {}
+
+std::future<void> execution_pool::submit(std::function<void()> fn) {
+  std::packaged_task<void()> task(std::move(fn));
+  auto future = task.get_future();
+  bool grow;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+    tasks_.push_back(std::move(task));
+    grow = tasks_.size() > idle_;
+  }
+  if (grow) {
+    reap();
+    spawn();
+  }
+  cv_.notify_one();
+  return future;
+}
+
+void execution_pool::spawn() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  // Threads inherit the signal mask of the thread that creates them.
+  sigset_t set, old_set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGINT);
+  pthread_sigmask(SIG_BLOCK, &set, &old_set);
+#endif
+  std::thread thread(&execution_pool::work, this);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.push_back(std::move(thread));
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  pthread_sigmask(SIG_SETMASK, &old_set, NULL);
+#endif
+}
+
+void execution_pool::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    ++idle_;
+    bool has_task = cv_.wait_for(lock, max_idle_, [this]() {
+      return !tasks_.empty() || stopping_;
+    });
+    --idle_;
+    if (stopping_) {
+      return;
+    }
+    if (!has_task) {
+      exited_.push_back(std::this_thread::get_id());
+      return;
+    }
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    // Exceptions end up in the task's future.
+    task();
+    lock.lock();
+  }
+}
+
+void execution_pool::reap() {
+  std::list<std::thread> exited;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto id : exited_) {
+      for (auto it = threads_.begin(); it != threads_.end(); ++it) {
+        if (it->get_id() == id) {
+          exited.splice(exited.end(), threads_, it);
+          break;
+        }
+      }
+    }
+    exited_.clear();
+  }
+  for (auto& thread : exited) {
+    thread.join();
+  }
+}
+
+void execution_pool::shutdown() {
+  std::list<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    threads.swap(threads_);
+    exited_.clear();
+  }
+  cv_.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace odbc
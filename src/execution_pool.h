@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace odbc {
+
+/// \brief Process wide pool of threads that statements are executed on.
+///
+/// Starting a thread per statement dominates the cost of executing many
+/// small statements, so threads are kept around and handed tasks through a
+/// condition variable.  The pool grows whenever a task is submitted while
+/// no thread is idle, so that statements on different connections never
+/// wait for each other; threads that stay idle for `max_idle` exit.
+///
+/// SIGINT is masked in all pool threads, so that user interrupts are
+/// delivered to the main [R] thread.
+class execution_pool {
+public:
+  static execution_pool& instance();
+
+  /// \brief Run `fn` on a pool thread.
+  ///
+  /// Exceptions thrown by `fn` are stored in the returned future.
+  std::future<void> submit(std::function<void()> fn);
+
+  /// \brief Stop and join all pool threads, waiting for running tasks.
+  ///
+  /// Called before the package's shared library is unloaded, so that no
+  /// idle thread wakes up in unmapped code.
+  void shutdown();
+
+private:
+  execution_pool();
+
+  void spawn();
+  void work();
+  // Join the threads that exited after being idle for `max_idle`.
+  void reap();
+
+  std::deque<std::packaged_task<void()>> tasks_;
+  std::list<std::thread> threads_;
+  std::vector<std::thread::id> exited_;
+  bool stopping_;
+  size_t idle_;
+  std::chrono::seconds max_idle_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+} // namespace odbc
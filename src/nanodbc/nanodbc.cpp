@@ -16,6 +16,7 @@
 #include "nanodbc.h"
 
 #include <algorithm>
+#include <atomic>
 #include <clocale>
 #include <cstdio>
 #include <cstring>
@@ -225,10 +226,51 @@ using nanodbc::wide_string_type;
         FUNC(__VA_ARGS__);                                                                         \
     } while (false) /**/
 #else
-#define NANODBC_CALL_RC(FUNC, RC, ...) RC = FUNC(__VA_ARGS__)
-#define NANODBC_CALL(FUNC, ...) FUNC(__VA_ARGS__)
+// Calls are timed only while a nanodbc::call_tracer is installed.
+#define NANODBC_CALL_RC(FUNC, RC, ...)                                                             \
+    do                                                                                             \
+    {                                                                                              \
+        nanodbc::call_tracer* nanodbc_tracer = nanodbc_current_tracer();                           \
+        if (nanodbc_tracer == nullptr)                                                             \
+        {                                                                                          \
+            RC = FUNC(__VA_ARGS__);                                                                \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            auto nanodbc_start = nanodbc::call_tracer::clock::now();                               \
+            RC = FUNC(__VA_ARGS__);                                                                \
+            nanodbc_tracer->on_call(                                                               \
+                NANODBC_STRINGIZE(FUNC), nanodbc_start, nanodbc::call_tracer::clock::now());       \
+        }                                                                                          \
+    } while (false) /**/
+#define NANODBC_CALL(FUNC, ...)                                                                    \
+    do                                                                                             \
+    {                                                                                              \
+        nanodbc::call_tracer* nanodbc_tracer = nanodbc_current_tracer();                           \
+        if (nanodbc_tracer == nullptr)                                                             \
+        {                                                                                          \
+            FUNC(__VA_ARGS__);                                                                     \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            auto nanodbc_start = nanodbc::call_tracer::clock::now();                               \
+            FUNC(__VA_ARGS__);                                                                     \
+            nanodbc_tracer->on_call(                                                               \
+                NANODBC_STRINGIZE(FUNC), nanodbc_start, nanodbc::call_tracer::clock::now());       \
+        }                                                                                          \
+    } while (false) /**/
 #endif
 
+namespace
+{
+std::atomic<nanodbc::call_tracer*> nanodbc_tracer_{nullptr};
+
+inline nanodbc::call_tracer* nanodbc_current_tracer()
+{
+    return nanodbc_tracer_.load(std::memory_order_acquire);
+}
+} // namespace
+
 // clang-format off
 // 8888888888                                      888    888                        888 888 d8b
 // 888                                             888    888                        888 888 Y8P
@@ -715,6 +757,7 @@ public:
         , ctype_(0)
         , clen_(0)
         , blob_(false)
+        , nullable_(true)
         , cbdata_(0)
         , pdata_(0)
         , bound_(false)
@@ -736,6 +779,7 @@ public:
     SQLSMALLINT ctype_;
     SQLULEN clen_;
     bool blob_;
+    bool nullable_;
     nanodbc::null_type* cbdata_;
     char* pdata_;
     bool bound_;
@@ -1524,6 +1568,29 @@ public:
         if (!open_)
             NANODBC_THROW_DATABASE_ERROR(stmt_, SQL_HANDLE_STMT);
         conn_ = conn;
+        for (const auto& attribute : attributes_)
+            apply_attribute(attribute.first, attribute.second);
+    }
+
+    void set_attribute(long attribute, long value)
+    {
+        attributes_[attribute] = value;
+        if (open())
+            apply_attribute(attribute, value);
+    }
+
+    void apply_attribute(long attribute, long value)
+    {
+        RETCODE rc;
+        NANODBC_CALL_RC(
+            SQLSetStmtAttr,
+            rc,
+            stmt_,
+            (SQLINTEGER)attribute,
+            (SQLPOINTER)(std::intptr_t)value,
+            SQL_IS_INTEGER);
+        if (!success(rc))
+            NANODBC_THROW_DATABASE_ERROR(stmt_, SQL_HANDLE_STMT);
     }
 
     bool open() const { return open_; }
@@ -1935,6 +2002,18 @@ public:
         NANODBC_CALL(SQLFreeStmt, stmt_, SQL_RESET_PARAMS);
     }
 
+    void close_cursor() NANODBC_NOEXCEPT
+    {
+        if (!open())
+            return;
+        NANODBC_CALL(SQLFreeStmt, stmt_, SQL_CLOSE);
+        NANODBC_CALL(SQLFreeStmt, stmt_, SQL_UNBIND);
+        NANODBC_CALL(SQLFreeStmt, stmt_, SQL_RESET_PARAMS);
+#ifndef NANODBC_DISABLE_MSSQL_TVP
+        tvp_data_.clear();
+#endif
+    }
+
     short parameters() const
     {
         SQLSMALLINT params;
@@ -2248,6 +2327,7 @@ private:
     std::map<short, std::vector<string_type::value_type>> string_data_;
     std::map<short, std::vector<uint8_t>> binary_data_;
     std::map<short, bound_parameter> param_descr_data_;
+    std::map<long, long> attributes_; // applied whenever a handle is allocated
 
 #if defined(NANODBC_DO_ASYNC_IMPL)
     bool async_;                 // true if statement is currently in SQL_STILL_EXECUTING mode
@@ -3197,6 +3277,8 @@ public:
 #if defined(NANODBC_DO_ASYNC_IMPL)
         , async_(false)
 #endif
+        , get_data_calls_(0)
+        , get_data_bytes_(0)
     {
         RETCODE rc;
         NANODBC_CALL_RC(
@@ -3459,6 +3541,21 @@ public:
         return col.ctype_;
     }
 
+    bool column_nullable(short column) const
+    {
+        if (column >= bound_columns_size_)
+            throw index_range_error();
+        bound_column& col = bound_columns_[column];
+        return col.nullable_;
+    }
+
+    bool column_nullable(const string_type& column_name) const
+    {
+        const short column = this->column(column_name);
+        bound_column& col = bound_columns_[column];
+        return col.nullable_;
+    }
+
     bool next_result()
     {
         RETCODE rc;
@@ -3594,6 +3691,10 @@ public:
         return result;
     }
 
+    std::size_t get_data_calls() const { return get_data_calls_; }
+
+    std::size_t get_data_bytes() const { return get_data_bytes_; }
+
 private:
     template <typename T>
     std::unique_ptr<T, std::function<void(T*)>> ensure_pdata(short column) const;
@@ -3710,6 +3811,8 @@ private:
             col.sqltype_ = sqltype;
             col.sqlsize_ = sqlsize;
             col.scale_ = scale;
+            // SQL_NULLABLE_UNKNOWN is treated as nullable.
+            col.nullable_ = nullable != SQL_NO_NULLS;
             bound_columns_by_name_[col.name_] = &col;
 
             using namespace std; // if int64_t is in std namespace (in c++11)
@@ -3834,6 +3937,21 @@ private:
         }
     }
 
+    // Counts a SQLGetData call and the bytes it returned into a buffer of
+    // buffer_size bytes.
+    void count_get_data(SQLLEN indicator, std::size_t buffer_size) const
+    {
+        ++get_data_calls_;
+        std::size_t bytes = 0;
+        if (indicator == SQL_NO_TOTAL)
+            bytes = buffer_size;
+        else if (indicator > 0)
+            bytes = std::min<std::size_t>(indicator, buffer_size);
+        get_data_bytes_ += bytes;
+        if (call_tracer* tracer = nanodbc_current_tracer())
+            tracer->on_bytes("SQLGetData", bytes);
+    }
+
 private:
     statement stmt_;
     const long rowset_size_;
@@ -3846,6 +3964,8 @@ private:
 #if defined(NANODBC_DO_ASYNC_IMPL)
     bool async_; // true if statement is currently in SQL_STILL_EXECUTING mode
 #endif
+    mutable std::size_t get_data_calls_; // SQLGetData calls for unbound columns
+    mutable std::size_t get_data_bytes_; // bytes returned by those calls
 };
 
 template <>
@@ -4000,6 +4120,7 @@ inline void result::result_impl::get_ref_impl<string_type>(short column, string_
                     buffer,          // TargetValuePtr
                     buffer_size,     // BufferLength
                     &ValueLenOrInd); // StrLen_or_IndPtr
+                count_get_data(ValueLenOrInd, buffer_size);
                 if (ValueLenOrInd == SQL_NO_TOTAL)
                     out.append(buffer, col.ctype_ == SQL_C_BINARY ? buffer_size : buffer_size - 1);
                 else if (ValueLenOrInd > 0)
@@ -4058,6 +4179,7 @@ inline void result::result_impl::get_ref_impl<string_type>(short column, string_
                     buffer,          // TargetValuePtr
                     buffer_size,     // BufferLength
                     &ValueLenOrInd); // StrLen_or_IndPtr
+                count_get_data(ValueLenOrInd, buffer_size);
                 if (ValueLenOrInd == SQL_NO_TOTAL)
                     out.append(buffer, (buffer_size / sizeof(wide_char_t)) - 1);
                 else if (ValueLenOrInd > 0)
@@ -4233,6 +4355,78 @@ inline void result::result_impl::get_ref_impl<string_type>(short column, string_
     throw type_incompatible_error();
 }
 
+#ifndef NANODBC_USE_UNICODE
+// Retrieve character data as UTF-16 (UTF-32 with iODBC) code units without
+// going through std::string.  For SQL_C_WCHAR columns this copies straight
+// from the bound buffer (or from SQLGetData) into `result`, re-using its
+// capacity across calls; this lets callers run their own UTF-8 conversion
+// into a buffer they own.
+template <>
+inline void
+result::result_impl::get_ref_impl<wide_string_type>(short column, wide_string_type& result) const
+{
+    bound_column& col = bound_columns_[column];
+
+    if (col.ctype_ != SQL_C_WCHAR)
+    {
+        std::string narrow;
+        get_ref_impl<std::string>(column, narrow);
+        convert(narrow, result);
+        return;
+    }
+
+    if (is_bound(column))
+    {
+        const wide_char_t* s =
+            reinterpret_cast<wide_char_t*>(col.pdata_ + rowset_position_ * col.clen_);
+        // Same clamp as for string_type: never read past pdata_.
+        const wide_string_type::size_type str_size = std::min<wide_string_type::size_type>(
+            col.cbdata_[rowset_position_] / sizeof(wide_char_t), col.clen_ / sizeof(wide_char_t));
+        result.assign(s, s + str_size);
+        return;
+    }
+
+    result.clear();
+    SQLLEN ValueLenOrInd;
+    SQLRETURN rc;
+
+#if defined(NANODBC_DO_ASYNC_IMPL)
+    stmt_.disable_async();
+#endif
+
+    void* handle = native_statement_handle();
+    do
+    {
+        wide_char_t buffer[512] = {0};
+        const std::size_t buffer_size = sizeof(buffer);
+        NANODBC_CALL_RC(
+            SQLGetData,
+            rc,
+            handle,          // StatementHandle
+            column + 1,      // Col_or_Param_Num
+            col.ctype_,      // TargetType
+            buffer,          // TargetValuePtr
+            buffer_size,     // BufferLength
+            &ValueLenOrInd); // StrLen_or_IndPtr
+        count_get_data(ValueLenOrInd, buffer_size);
+        if (ValueLenOrInd == SQL_NO_TOTAL)
+            result.append(buffer, (buffer_size / sizeof(wide_char_t)) - 1);
+        else if (ValueLenOrInd > 0)
+            result.append(
+                buffer,
+                std::min<std::size_t>(
+                    ValueLenOrInd / sizeof(wide_char_t),
+                    (buffer_size / sizeof(wide_char_t)) - 1));
+        else if (ValueLenOrInd == SQL_NULL_DATA)
+            col.cbdata_[rowset_position_] = (SQLINTEGER)SQL_NULL_DATA;
+        // Sequence of successful calls is:
+        // SQL_NO_DATA or SQL_SUCCESS_WITH_INFO followed by SQL_SUCCESS.
+    } while (rc == SQL_SUCCESS_WITH_INFO);
+    if (!success(rc) && rc != SQL_NO_DATA)
+        NANODBC_THROW_DATABASE_ERROR(stmt_.native_statement_handle(), SQL_HANDLE_STMT);
+}
+#endif
+
 template <>
 inline void result::result_impl::get_ref_impl<std::vector<std::uint8_t>>(
     short column,
@@ -4273,6 +4467,7 @@ inline void result::result_impl::get_ref_impl<std::vector<std::uint8_t>>(
                     buffer,          // TargetValuePtr
                     buffer_size,     // BufferLength
                     &ValueLenOrInd); // StrLen_or_IndPtr
+                count_get_data(ValueLenOrInd, buffer_size);
                 if (ValueLenOrInd > 0)
                 {
                     auto const buffer_size_filled =
@@ -4328,6 +4523,7 @@ std::unique_ptr<T, std::function<void(T*)>> result::result_impl::ensure_pdata(sh
         buffer.get(),        // TargetValuePtr
         buffer_size,         // BufferLength
         &ValueLenOrInd);     // StrLen_or_IndPtr
+    count_get_data(ValueLenOrInd, buffer_size);
 
     if (ValueLenOrInd == SQL_NULL_DATA)
         col.cbdata_[static_cast<size_t>(rowset_position_)] = (SQLINTEGER)SQL_NULL_DATA;
@@ -4395,6 +4591,11 @@ void result::result_impl::get_ref_impl(short column, T& result) const
 namespace nanodbc
 {
 
+void set_call_tracer(call_tracer* tracer)
+{
+    nanodbc_tracer_.store(tracer, std::memory_order_release);
+}
+
 std::list<driver> list_drivers()
 {
     NANODBC_SQLCHAR descr[1024] = {0};
@@ -5058,6 +5259,16 @@ void statement::reset_parameters() NANODBC_NOEXCEPT
     impl_->reset_parameters();
 }
 
+void statement::close_cursor() NANODBC_NOEXCEPT
+{
+    impl_->close_cursor();
+}
+
+void statement::set_attribute(long attribute, long value)
+{
+    impl_->set_attribute(attribute, value);
+}
+
 unsigned long statement::parameter_size(short param_index) const
 {
     return impl_->parameter_size(param_index);
@@ -6070,6 +6281,16 @@ bool result::move(long row)
     return impl_->move(row);
 }
 
+std::size_t result::get_data_calls() const
+{
+    return impl_->get_data_calls();
+}
+
+std::size_t result::get_data_bytes() const
+{
+    return impl_->get_data_bytes();
+}
+
 bool result::skip(long rows)
 {
     return impl_->skip(rows);
@@ -6155,6 +6376,16 @@ int result::column_c_datatype(const string_type& column_name) const
     return impl_->column_c_datatype(column_name);
 }
 
+bool result::column_nullable(short column) const
+{
+    return impl_->column_nullable(column);
+}
+
+bool result::column_nullable(const string_type& column_name) const
+{
+    return impl_->column_nullable(column_name);
+}
+
 bool result::next_result()
 {
     return impl_->next_result();
@@ -6245,6 +6476,9 @@ template void result::get_ref(short, date&) const;
 template void result::get_ref(short, time&) const;
 template void result::get_ref(short, timestamp&) const;
 template void result::get_ref(short, std::vector<std::uint8_t>&) const;
+#ifndef NANODBC_USE_UNICODE
+template void result::get_ref(short, wide_string_type&) const;
+#endif
 
 template void result::get_ref(const string_type&, string_type::value_type&) const;
 template void result::get_ref(const string_type&, short&) const;
@@ -6282,6 +6516,9 @@ template void result::get_ref(short, const time&, time&) const;
 template void result::get_ref(short, const timestamp&, timestamp&) const;
 template void
 result::get_ref(short, const std::vector<std::uint8_t>&, std::vector<std::uint8_t>&) const;
+#ifndef NANODBC_USE_UNICODE
+template void result::get_ref(short, const wide_string_type&, wide_string_type&) const;
+#endif
 
 template void
 result::get_ref(const string_type&, const string_type::value_type&, string_type::value_type&) const;
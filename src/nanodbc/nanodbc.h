@@ -76,6 +76,7 @@
 #ifndef NANODBC_H
 #define NANODBC_H
 
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <list>
@@ -375,6 +376,30 @@ using enable_if_string = typename std::enable_if<is_string<T>::value>::type;
 template <typename T>
 using enable_if_character = typename std::enable_if<is_character<T>::value>::type;
 
+/// \brief Receives the timings of the ODBC calls nanodbc makes.
+///
+/// Install one with set_call_tracer().  ODBC calls are made from whichever thread uses a
+/// connection, so implementations must be thread safe.
+class call_tracer
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    virtual ~call_tracer() = default;
+
+    /// \brief Called after the ODBC function `function` returned.
+    virtual void on_call(const char* function, clock::time_point start, clock::time_point end) = 0;
+
+    /// \brief Called with the number of bytes of column data returned by `function`.
+    virtual void on_bytes(const char* function, std::size_t bytes) = 0;
+};
+
+/// \brief Install `tracer`, or remove the installed tracer with `nullptr`.
+///
+/// The tracer is not owned by nanodbc, and must outlive any ODBC call in progress when it is
+/// removed.  Without a tracer, the cost of tracing is one atomic load per ODBC call.
+void set_call_tracer(call_tracer* tracer);
+
 /// \}
 
 /// \addtogroup mainc Main classes
@@ -956,6 +981,21 @@ public:
     /// \brief Resets all currently bound parameters.
     void reset_parameters() NANODBC_NOEXCEPT;
 
+    /// \brief Closes any open cursor and unbinds all columns and parameters.
+    ///
+    /// Unlike close(), the statement stays prepared and keeps the parameter
+    /// descriptions, so it can be bound and executed again.
+    void close_cursor() NANODBC_NOEXCEPT;
+
+    /// \brief Sets an integer valued statement attribute, such as
+    /// SQL_ATTR_CURSOR_TYPE.
+    ///
+    /// The attribute is remembered and set again whenever the statement
+    /// allocates a new handle, e.g. in prepare(connection&, ...) or
+    /// execute_direct(), so it can be set before the statement is opened.
+    /// \throws database_error
+    void set_attribute(long attribute, long value);
+
     /// \brief Returns the number of parameters in the statement.
     /// \throws database_error
     short parameters() const;
@@ -1586,6 +1626,12 @@ public:
     /// \throws database_error
     bool move(long row);
 
+    /// \brief Number of SQLGetData calls made to retrieve unbound columns.
+    std::size_t get_data_calls() const;
+
+    /// \brief Number of bytes retrieved by SQLGetData calls.
+    std::size_t get_data_bytes() const;
+
     /// \brief Skips a number of rows and then fetches the resulting row in the current result set.
     /// \return true if there are results or false otherwise.
     /// \throws database_error
@@ -1794,6 +1840,16 @@ public:
     /// \brief Returns a identifying integer value representing the C type of this column by name.
     int column_c_datatype(const string_type& column_name) const;
 
+    /// \brief Returns false only if the driver reports the column as SQL_NO_NULLS.
+    ///
+    /// Columns whose nullability is unknown are reported as nullable.
+    /// \param column position.
+    /// \throws index_range_error
+    bool column_nullable(short column) const;
+
+    /// \brief Returns false only if the driver reports the column by name as SQL_NO_NULLS.
+    bool column_nullable(const string_type& column_name) const;
+
     /// \brief Returns the next result, e.g. when stored procedure returns multiple result sets.
     bool next_result();
 
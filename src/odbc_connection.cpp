@@ -17,7 +17,21 @@ bool odbc_connection::has_result() const {
   return current_result_ != nullptr;
 }
 
+bool odbc_connection::multiple_results() const { return multiple_results_; }
+
+void odbc_connection::wait_for_pending() {
+  if (pending_result_ != nullptr) {
+    pending_result_->wait(false);
+  }
+}
+
 void odbc_connection::set_current_result(odbc_result* r) {
+  if (multiple_results_) {
+    if (r != nullptr) {
+      active_results_.insert(r);
+    }
+    return;
+  }
   if (r == current_result_) {
     return;
   }
@@ -26,6 +40,22 @@ void odbc_connection::set_current_result(odbc_result* r) {
   current_result_ = r;
 }
 
+void odbc_connection::release_result(odbc_result* r) {
+  if (!multiple_results_) {
+    if (r == current_result_) {
+      cancel_current_result();
+    }
+    return;
+  }
+  if (active_results_.erase(r) == 0) {
+    return;
+  }
+  auto s = r->statement();
+  if (s) {
+    s->cancel();
+  }
+}
+
 odbc_connection::odbc_connection(
     std::string const& connection_string,
     std::string const& timezone,
@@ -35,13 +65,34 @@ odbc_connection::odbc_connection(
     bigint_map_t const& bigint_mapping,
     long const& timeout,
     Rcpp::Nullable<Rcpp::List> const& r_attributes,
-    bool const& interruptible_execution)
+    bool const& interruptible_execution,
+    bool const& pooled,
+    size_t const& statement_cache_size,
+    bool const& multiple_results,
+    double const& catalog_cache_ttl,
+    double const& max_result_bytes)
     : current_result_(nullptr),
+      multiple_results_(multiple_results),
+      pending_result_(nullptr),
+      timezone_str_(timezone),
       timezone_out_str_(timezone_out),
+      encoding_(encoding),
+      name_encoding_(name_encoding),
       bigint_mapping_(bigint_mapping),
       output_encoder_(nullptr),
       column_name_encoder_(nullptr),
-      interruptible_execution_(interruptible_execution) {
+      interruptible_execution_(interruptible_execution),
+      max_result_bytes_(max_result_bytes),
+      pooled_(pooled),
+      created_(connection_pool::clock::now()),
+      statement_cache_size_(statement_cache_size),
+      statement_cache_hits_(0),
+      statement_cache_misses_(0),
+      statement_cache_evictions_(0),
+      statements_survive_transactions_(-1),
+      catalog_cache_ttl_(catalog_cache_ttl),
+      catalog_cache_hits_(0),
+      catalog_cache_misses_(0) {
 
   output_encoder_ = std::make_shared<Iconv>(encoding, "UTF-8");
   column_name_encoder_ = std::make_shared<Iconv>(name_encoding, "UTF-8");
@@ -55,6 +106,16 @@ odbc_connection::odbc_connection(
     Rcpp::stop("Error loading timezone_out (%s)", timezone_out);
   }
 
+  if (pooled_) {
+    pool_key_ = connection_pool::key(connection_string, timeout, r_attributes);
+    connection_pool::entry e;
+    if (connection_pool::instance().acquire(pool_key_, e)) {
+      c_ = e.connection;
+      created_ = e.created;
+      return;
+    }
+  }
+
   try {
     std::list< nanodbc::connection::attribute > attributes;
     std::list< std::shared_ptr< void > > buffer_context;
@@ -66,34 +127,66 @@ odbc_connection::odbc_connection(
   }
 }
 
+odbc_connection::~odbc_connection() {
+  // Statements belong to this connection and are freed before it is closed
+  // or handed back to the pool.
+  clear_statement_cache();
+  if (!pooled_ || !c_) {
+    return;
+  }
+  try {
+    // Leave the connection as a new one would find it.
+    if (t_) {
+      t_->rollback();
+      t_.reset();
+    }
+    // Results keep their connection alive, so none should be outstanding;
+    // a connection still shared with anything else is not safe to lend out.
+    if (!has_active_result() && c_.use_count() == 1 && c_->connected()) {
+      connection_pool::instance().release(
+          pool_key_, {std::move(c_), created_, created_});
+    }
+  } catch (...) {
+    // Fall back to closing the connection.
+  }
+}
+
 std::shared_ptr<nanodbc::connection> odbc_connection::connection() const {
   return std::shared_ptr<nanodbc::connection>(c_);
 }
 
 void odbc_connection::begin() {
+  wait_for_pending();
   if (t_) {
     Rcpp::stop("Double begin");
   }
   t_ = std::unique_ptr<nanodbc::transaction>(new nanodbc::transaction(*c_));
 }
 void odbc_connection::commit() {
+  wait_for_pending();
   if (!t_) {
     Rcpp::stop("Commit without beginning transaction");
   }
   t_->commit();
   t_.reset();
+  on_transaction_end();
 }
 void odbc_connection::rollback() {
+  wait_for_pending();
   if (!t_) {
     Rcpp::stop("Rollback without beginning transaction");
   }
   t_->rollback();
   t_.reset();
+  on_transaction_end();
 }
 bool odbc_connection::has_active_result() const {
-  return current_result_ != nullptr;
+  return current_result_ != nullptr || !active_results_.empty();
 }
 bool odbc_connection::is_current_result(odbc_result* result) const {
+  if (multiple_results_) {
+    return active_results_.count(result) > 0;
+  }
   return current_result_ == result;
 }
 bool odbc_connection::supports_transactions() const {
@@ -136,4 +229,146 @@ bigint_map_t odbc_connection::get_bigint_mapping() const {
   return bigint_mapping_;
 }
 
+Rcpp::List odbc_connection::decode_settings() const {
+  return Rcpp::List::create(
+      Rcpp::_["timezone"] = timezone_str_,
+      Rcpp::_["timezone_out"] = timezone_out_str_,
+      Rcpp::_["encoding"] = encoding_,
+      Rcpp::_["name_encoding"] = name_encoding_,
+      Rcpp::_["bigint"] = static_cast<int>(bigint_mapping_));
+}
+
+double odbc_connection::max_result_bytes() const { return max_result_bytes_; }
+
+std::shared_ptr<nanodbc::statement>
+odbc_connection::cached_statement(std::string const& sql) {
+  if (statement_cache_size_ == 0) {
+    return nullptr;
+  }
+  auto it = statement_index_.find(sql);
+  // A use count above one means a live result is still using the statement.
+  if (it == statement_index_.end() || it->second->second.use_count() > 1) {
+    ++statement_cache_misses_;
+    return nullptr;
+  }
+  auto s = it->second->second;
+  if (!s->open()) {
+    // Closed after a failed execution; prepare afresh.
+    statements_.erase(it->second);
+    statement_index_.erase(it);
+    ++statement_cache_misses_;
+    return nullptr;
+  }
+  statements_.splice(statements_.begin(), statements_, it->second);
+  ++statement_cache_hits_;
+  return s;
+}
+
+void odbc_connection::cache_statement(
+    std::string const& sql, std::shared_ptr<nanodbc::statement> const& s) {
+  if (statement_cache_size_ == 0) {
+    return;
+  }
+  auto it = statement_index_.find(sql);
+  if (it != statement_index_.end()) {
+    // The cached statement is in use by another result; keep that one.
+    return;
+  }
+  statements_.emplace_front(sql, s);
+  statement_index_[sql] = statements_.begin();
+  while (statements_.size() > statement_cache_size_) {
+    statement_index_.erase(statements_.back().first);
+    statements_.pop_back();
+    ++statement_cache_evictions_;
+  }
+}
+
+void odbc_connection::on_transaction_end() {
+  if (statements_.empty()) {
+    return;
+  }
+  if (statements_survive_transactions_ < 0) {
+    try {
+      statements_survive_transactions_ =
+          c_->get_info<unsigned short>(SQL_CURSOR_COMMIT_BEHAVIOR) !=
+              SQL_CB_DELETE &&
+          c_->get_info<unsigned short>(SQL_CURSOR_ROLLBACK_BEHAVIOR) !=
+              SQL_CB_DELETE;
+    } catch (const nanodbc::database_error& e) {
+      statements_survive_transactions_ = 0;
+    }
+  }
+  if (!statements_survive_transactions_) {
+    clear_statement_cache();
+  }
+}
+
+void odbc_connection::clear_statement_cache() {
+  statement_index_.clear();
+  statements_.clear();
+}
+
+odbc_connection::statement_cache_stats
+odbc_connection::get_statement_cache_stats() const {
+  return {
+      statement_cache_hits_,
+      statement_cache_misses_,
+      statement_cache_evictions_,
+      statements_.size(),
+      statement_cache_size_};
+}
+
+SEXP odbc_connection::cached_catalog(std::string const& key) {
+  if (catalog_cache_ttl_.count() <= 0) {
+    return R_NilValue;
+  }
+  auto it = catalog_cache_.find(key);
+  if (it == catalog_cache_.end()) {
+    ++catalog_cache_misses_;
+    return R_NilValue;
+  }
+  if (connection_pool::clock::now() - it->second.created > catalog_cache_ttl_) {
+    catalog_cache_.erase(it);
+    ++catalog_cache_misses_;
+    return R_NilValue;
+  }
+  ++catalog_cache_hits_;
+  return it->second.value;
+}
+
+void odbc_connection::cache_catalog(std::string const& key, SEXP value) {
+  if (catalog_cache_ttl_.count() <= 0) {
+    return;
+  }
+  auto now = connection_pool::clock::now();
+  for (auto it = catalog_cache_.begin(); it != catalog_cache_.end();) {
+    if (now - it->second.created > catalog_cache_ttl_) {
+      it = catalog_cache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  MARK_NOT_MUTABLE(value);
+  catalog_cache_[key] = {Rcpp::RObject(value), now};
+}
+
+void odbc_connection::clear_catalog_cache() { catalog_cache_.clear(); }
+
+odbc_connection::catalog_cache_stats
+odbc_connection::get_catalog_cache_stats() const {
+  return {
+      catalog_cache_hits_,
+      catalog_cache_misses_,
+      catalog_cache_.size(),
+      catalog_cache_ttl_.count()};
+}
+
+void odbc_connection::add_result_stats(result_stats const& x) {
+  result_stats_ += x;
+}
+
+result_stats const& odbc_connection::get_result_stats() const {
+  return result_stats_;
+}
+
 } // namespace odbc
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "connection_pool.h"
 #include "nanodbc.h"
+#include "result_stats.h"
 #include "sql_types.h"
 #include "time_zone.h"
 #include <Rcpp.h>
 // Important that this header is included after Rcpp.h
 #include "Iconv.h"
+#include <list>
+#include <map>
+#include <set>
+#include <unordered_map>
 
 namespace odbc {
 
@@ -30,7 +36,16 @@ public:
       bigint_map_t const& bigint_mapping = i64_to_integer64,
       long const& timeout = 0,
       Rcpp::Nullable<Rcpp::List> const& r_attributes = R_NilValue,
-      bool const& interruptible_execution = true);
+      bool const& interruptible_execution = true,
+      bool const& pooled = false,
+      size_t const& statement_cache_size = 0,
+      bool const& multiple_results = false,
+      double const& catalog_cache_ttl = 0,
+      double const& max_result_bytes = 0);
+
+  /// Pooled connections are handed back to `connection_pool` rather than
+  /// closed, provided no transaction or result is outstanding.
+  ~odbc_connection();
 
   std::shared_ptr<nanodbc::connection> connection() const;
 
@@ -44,8 +59,23 @@ public:
 
   void cancel_current_result();
   void set_current_result(odbc_result* r);
+  /// \brief Cancel `r` and stop tracking it, if it is active.
+  void release_result(odbc_result* r);
+  /// \brief Whether sending a new query would cancel an active result.
   bool has_result() const;
 
+  /// \brief Wait for a result executing asynchronously on this connection,
+  /// if any, to finish.  Its errors are left for the result to raise.
+  void wait_for_pending();
+
+  /// \brief Whether several results may be active at once.
+  ///
+  /// In this mode every result keeps its own statement handle and is only
+  /// cancelled when it is cleared; new queries leave other results alone.
+  /// The driver has to support more than one active statement per
+  /// connection (e.g. Multiple Active Result Sets on SQL Server).
+  bool multiple_results() const;
+
   cctz::time_zone timezone() const;
   std::string timezone_out_str() const;
   const std::shared_ptr<Iconv> output_encoder() const;
@@ -53,16 +83,118 @@ public:
 
   bigint_map_t get_bigint_mapping() const;
 
+  /// \brief The settings that change how results are decoded into R values,
+  /// by name: `timezone`, `timezone_out`, `encoding`, `name_encoding` and
+  /// `bigint`.  Results are cached per connection with these settings.
+  Rcpp::List decode_settings() const;
+
+  /// \brief The most memory, in bytes, a data frame fetched from a result
+  /// on this connection may use; `0` or `Inf` if there is no limit, `NA`
+  /// to use the `odbc.max_result_bytes` option.
+  double max_result_bytes() const;
+
+  /// \brief Look up a prepared statement for `sql`.
+  ///
+  /// Only statements that no live result is using are handed out.  Returns
+  /// nullptr on a miss, in which case the caller prepares a new statement
+  /// and may offer it to the cache with `cache_statement`.
+  std::shared_ptr<nanodbc::statement> cached_statement(std::string const& sql);
+
+  /// \brief Keep a prepared statement for re-use, evicting the least
+  /// recently used statement if the cache is full.
+  void cache_statement(
+      std::string const& sql, std::shared_ptr<nanodbc::statement> const& s);
+
+  /// \brief Drop all cached statements if the driver discards prepared
+  /// statements when a transaction ends.
+  void on_transaction_end();
+
+  struct statement_cache_stats {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t size;
+    size_t capacity;
+  };
+  statement_cache_stats get_statement_cache_stats() const;
+
+  /// \brief Look up a catalog listing (e.g. from `SQLColumns`) cached
+  /// under `key`.
+  ///
+  /// Returns `R_NilValue` on a miss, including when the entry is older than
+  /// the cache's time to live, or the cache is disabled.
+  SEXP cached_catalog(std::string const& key);
+
+  /// \brief Keep a catalog listing for `catalog_cache_ttl` seconds.
+  ///
+  /// `value` is marked as not mutable, so that [R] copies it before it is
+  /// modified.
+  void cache_catalog(std::string const& key, SEXP value);
+
+  /// \brief Forget all cached catalog listings, e.g. after creating or
+  /// dropping a table.
+  void clear_catalog_cache();
+
+  struct catalog_cache_stats {
+    size_t hits;
+    size_t misses;
+    size_t size;
+    double ttl;
+  };
+  catalog_cache_stats get_catalog_cache_stats() const;
+
+  /// \brief Add to the running totals of the results run on this
+  /// connection.
+  void add_result_stats(result_stats const& x);
+  result_stats const& get_result_stats() const;
+
 private:
   std::shared_ptr<nanodbc::connection> c_;
   std::unique_ptr<nanodbc::transaction> t_;
   odbc_result* current_result_;
+  // Active results, if `multiple_results_`; `current_result_` is unused then.
+  std::set<odbc_result*> active_results_;
+  bool multiple_results_;
+  // Result whose statement is executing on another thread, if any.
+  odbc_result* pending_result_;
   cctz::time_zone timezone_;
   cctz::time_zone timezone_out_;
+  std::string timezone_str_;
   std::string timezone_out_str_;
+  std::string encoding_;
+  std::string name_encoding_;
   bigint_map_t bigint_mapping_;
   std::shared_ptr<Iconv> output_encoder_;
   std::shared_ptr<Iconv> column_name_encoder_;
   bool interruptible_execution_;
+  double max_result_bytes_;
+  bool pooled_;
+  std::string pool_key_;
+  connection_pool::clock::time_point created_;
+
+  // Prepared statements by SQL text, most recently used first.
+  typedef std::list<std::pair<std::string, std::shared_ptr<nanodbc::statement>>>
+      statement_list;
+  statement_list statements_;
+  std::unordered_map<std::string, statement_list::iterator> statement_index_;
+  size_t statement_cache_size_;
+  size_t statement_cache_hits_;
+  size_t statement_cache_misses_;
+  size_t statement_cache_evictions_;
+  // -1 until SQL_CURSOR_COMMIT_BEHAVIOR has been looked up.
+  int statements_survive_transactions_;
+
+  void clear_statement_cache();
+
+  struct catalog_entry {
+    Rcpp::RObject value;
+    connection_pool::clock::time_point created;
+  };
+  std::map<std::string, catalog_entry> catalog_cache_;
+  std::chrono::duration<double> catalog_cache_ttl_;
+  size_t catalog_cache_hits_;
+  size_t catalog_cache_misses_;
+
+  result_stats result_stats_;
 };
 } // namespace odbc
@@ -1,9 +1,17 @@
 #include "odbc_result.h"
+#include "execution_pool.h"
 #include "integer64.h"
+#include "progress.h"
 #include "time_zone.h"
+#include "unicode.h"
 #include "utils.h"
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <sstream>
 
 #if R_VERSION < R_Version(4, 5, 0)
 #define Rf_isDataFrame(x) Rf_isFrame(x)
@@ -20,12 +28,218 @@
 #endif
 namespace odbc {
 
-using odbc::utils::run_interruptible;
+namespace {
+
+std::chrono::steady_clock::time_point deadline_after(double seconds) {
+  // Very long timeouts would overflow the clock.
+  if (seconds <= 0 || seconds > 1e9) {
+    return std::chrono::steady_clock::time_point::max();
+  }
+  return std::chrono::steady_clock::now() +
+         std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+             std::chrono::duration<double>(seconds));
+}
+
+// A transaction for a batch insert, if `begin`.  However it ends, by
+// `commit()` or by rolling back while unwinding from an error, the
+// connection's cached statements are dropped if the driver discards them.
+class transaction_scope {
+public:
+  transaction_scope(odbc_connection& c, bool begin) : c_(c) {
+    if (begin) {
+      t_.reset(new nanodbc::transaction(*c_.connection()));
+    }
+  }
+
+  ~transaction_scope() {
+    if (t_) {
+      t_.reset();
+      c_.on_transaction_end();
+    }
+  }
+
+  transaction_scope(transaction_scope const&) = delete;
+  transaction_scope& operator=(transaction_scope const&) = delete;
+
+  void commit() {
+    if (t_) {
+      t_->commit();
+    }
+  }
+
+private:
+  odbc_connection& c_;
+  std::unique_ptr<nanodbc::transaction> t_;
+};
+
+// Approximate memory used by an R vector with `bytes` bytes of data,
+// including its header on 64-bit platforms.
+double r_vector_bytes(double bytes) { return 48 + bytes; }
+
+// The `odbc.max_result_bytes` option, or 0 if it is not set.
+double option_max_result_bytes() {
+  SEXP option = Rf_GetOption1(Rf_install("odbc.max_result_bytes"));
+  return option == R_NilValue ? 0 : Rf_asReal(option);
+}
+
+// Memory used by one row of a data frame column of `type`, not counting the
+// strings or raw vectors it points to.
+double r_element_bytes(r_type type) {
+  switch (type) {
+  case integer_t:
+  case logical_t:
+    return sizeof(int);
+  case ustring_t:
+  case string_t:
+  case raw_t:
+  case dataframe_t:
+    return sizeof(SEXP);
+  default:
+    return sizeof(double);
+  }
+}
+
+// Element `i` of the indices of a dictionary encoded Arrow array.
+int64_t arrow_index(char format, const void* indices, int64_t i) {
+  switch (format) {
+  case 'c':
+    return static_cast<const int8_t*>(indices)[i];
+  case 's':
+    return static_cast<const int16_t*>(indices)[i];
+  case 'i':
+    return static_cast<const int32_t*>(indices)[i];
+  default:
+    return static_cast<const int64_t*>(indices)[i];
+  }
+}
+
+// UTF-8 `[start, end)` converted by `encoder`, if any.
+std::string encode_string(const char* start, const char* end, Iconv* encoder) {
+  return encoder ? encoder->makeString(start, end) : std::string(start, end);
+}
+
+// Parsers for the fields of delimited files.  Each consumes what it parses
+// from `p`.
+
+bool parse_digits(const char*& p, const char* end, int n, int& out) {
+  if (end - p < n) {
+    return false;
+  }
+  out = 0;
+  for (int i = 0; i < n; ++i, ++p) {
+    if (*p < '0' || *p > '9') {
+      return false;
+    }
+    out = out * 10 + (*p - '0');
+  }
+  return true;
+}
+
+bool parse_char(const char*& p, const char* end, char c) {
+  if (p == end || *p != c) {
+    return false;
+  }
+  ++p;
+  return true;
+}
+
+// YYYY-MM-DD
+bool parse_date(const char*& p, const char* end, int& y, int& m, int& d) {
+  return parse_digits(p, end, 4, y) && parse_char(p, end, '-') &&
+         parse_digits(p, end, 2, m) && parse_char(p, end, '-') &&
+         parse_digits(p, end, 2, d) && m >= 1 && m <= 12 && d >= 1 &&
+         d <= 31;
+}
+
+// HH:MM:SS, with an optional fraction of a second.
+bool parse_time(
+    const char*& p, const char* end, int& h, int& m, int& s, double& frac) {
+  if (!(parse_digits(p, end, 2, h) && parse_char(p, end, ':') &&
+        parse_digits(p, end, 2, m) && parse_char(p, end, ':') &&
+        parse_digits(p, end, 2, s) && h < 24 && m < 60 && s < 61)) {
+    return false;
+  }
+  frac = 0;
+  if (parse_char(p, end, '.')) {
+    if (p == end || *p < '0' || *p > '9') {
+      return false;
+    }
+    for (double scale = 0.1; p != end && *p >= '0' && *p <= '9'; ++p) {
+      frac += (*p - '0') * scale;
+      scale /= 10;
+    }
+  }
+  return true;
+}
+
+// `Z`, `+HH:MM`, `+HHMM` or `+HH`, as seconds east of UTC.
+bool parse_offset(const char*& p, const char* end, int& offset) {
+  offset = 0;
+  if (parse_char(p, end, 'Z')) {
+    return true;
+  }
+  if (p == end || (*p != '+' && *p != '-')) {
+    return false;
+  }
+  int sign = *p++ == '-' ? -1 : 1;
+  int h, m = 0;
+  if (!parse_digits(p, end, 2, h)) {
+    return false;
+  }
+  if (p != end) {
+    parse_char(p, end, ':');
+    if (!parse_digits(p, end, 2, m)) {
+      return false;
+    }
+  }
+  offset = sign * (h * 3600 + m * 60);
+  return true;
+}
+
+bool parse_integer(const char* p, const char* end, bool logical, int& out) {
+  std::string value(p, end);
+  if (logical) {
+    if (value == "TRUE" || value == "true" || value == "T") {
+      out = 1;
+      return true;
+    }
+    if (value == "FALSE" || value == "false" || value == "F") {
+      out = 0;
+      return true;
+    }
+  }
+  char* parsed;
+  errno = 0;
+  long x = std::strtol(value.c_str(), &parsed, 10);
+  if (value.empty() || *parsed != '\0' || errno == ERANGE ||
+      x < std::numeric_limits<int>::min() ||
+      x > std::numeric_limits<int>::max()) {
+    return false;
+  }
+  out = static_cast<int>(x);
+  return true;
+}
+
+bool parse_double(const char* p, const char* end, double& out) {
+  std::string value(p, end);
+  char* parsed;
+  out = std::strtod(value.c_str(), &parsed);
+  return !value.empty() && *parsed == '\0';
+}
+
+} // namespace
+
 using odbc::utils::raise_message;
 using odbc::utils::raise_warning;
 using odbc::utils::raise_error;
 odbc_result::odbc_result(
-    std::shared_ptr<odbc_connection> c, std::string sql, bool immediate)
+    std::shared_ptr<odbc_connection> c,
+    std::string sql,
+    bool immediate,
+    bool async,
+    long cursor_type,
+    long concurrency,
+    double timeout)
     : c_(c),
       sql_(sql),
       rows_fetched_(0),
@@ -33,32 +247,125 @@ odbc_result::odbc_result(
       complete_(0),
       bound_(false),
       immediate_(immediate),
+      cursor_type_(cursor_type),
+      concurrency_(concurrency),
+      positioned_(false),
+      prepared_(false),
+      // Timeouts are enforced from the main thread while executing away
+      // from it.
+      threaded_(c->interruptible_execution_ || async || timeout > 0),
+      timeout_(timeout),
+      deadline_(deadline_after(timeout)),
+      timed_out_(false),
+      result_bytes_(0),
       output_encoder_(c->output_encoder()),
       column_name_encoder_(c->column_name_encoder()) {
 
+  // Statements run asynchronously have the connection to themselves.
+  c_->wait_for_pending();
   c_->cancel_current_result();
-
-  if (c_->interruptible_execution_) {
-    auto exec_fn = std::mem_fn(&odbc_result::execute);
-    auto cancel_fn = [this]() {
-      this->c_->set_current_result(nullptr);
-    };
-    auto cleanup_fn = [this]() {
-      // set_current_result(nullptr) is safe to call
-      // multiple times.
-      this->c_->set_current_result(nullptr);
-      if (this->s_) {
-        this->s_->close();
-        this->s_.reset();
-      }
-    };
-    run_interruptible(std::bind(exec_fn, this), cancel_fn, cleanup_fn);
+  c_->set_current_result(this);
+
+  auto exec_fn = std::mem_fn(&odbc_result::execute);
+  if (threaded_) {
+    // Allocated here so that the main thread can cancel the statement
+    // while it executes.
+    s_ = new_statement();
+    pending_ = utils::run_async(std::bind(exec_fn, this));
+    if (async) {
+      c_->pending_result_ = this;
+    } else {
+      wait();
+    }
   } else {
     this->execute();
+    cache_statement();
+    report_stats();
   }
   return;
 }
 
+void odbc_result::cancel_execution() { c_->release_result(this); }
+
+void odbc_result::cleanup_execution() {
+  // release_result(this) is safe to call
+  // multiple times.
+  c_->release_result(this);
+  if (s_) {
+    s_->close();
+    s_.reset();
+  }
+}
+
+bool odbc_result::ready() const {
+  return !pending_.valid() ||
+         pending_.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+}
+
+void odbc_result::wait(bool raise) {
+  if (!pending_.valid()) {
+    return;
+  }
+  if (utils::wait_interruptible(
+          pending_, [this]() { this->cancel_execution(); }, deadline_)) {
+    timed_out_ = true;
+  }
+  if (c_->pending_result_ == this) {
+    c_->pending_result_ = nullptr;
+  }
+  if (raise) {
+    if (timed_out_) {
+      // Whatever the execution thread made of the cancellation.
+      pending_ = std::future<void>();
+      cleanup_execution();
+      raise_timeout();
+    }
+    utils::finish_async(pending_, [this]() { this->cleanup_execution(); });
+    cache_statement();
+    report_stats();
+  }
+}
+
+void odbc_result::report_stats() {
+  c_->add_result_stats(stats_ - reported_stats_);
+  reported_stats_ = stats_;
+}
+
+result_stats const& odbc_result::get_stats() const { return stats_; }
+
+long odbc_result::query_timeout() const {
+  if (timeout_ <= 0) {
+    return 0;
+  }
+  return static_cast<long>(std::ceil(std::min(timeout_, 1e9)));
+}
+
+void odbc_result::raise_timeout() const {
+  std::ostringstream message;
+  message << "Statement exceeded its timeout of " << timeout_
+          << " seconds and was cancelled.";
+  raise_error(message.str());
+}
+
+void odbc_result::raise_if_timed_out() const {
+  // The driver's error for a cancelled fetch says little about why.
+  if (timed_out_) {
+    raise_timeout();
+  }
+}
+
+void odbc_result::raise_memory_limit(double limit, int rows) const {
+  std::ostringstream message;
+  message << "Result exceeded the limit of "
+          << static_cast<unsigned long long>(limit) << " bytes after "
+          << rows << " rows and was cancelled. Fetch it in chunks with "
+          << "`dbSendQuery()` and `dbFetch(n = )`, or raise "
+          << "`max_result_bytes` in `dbConnect()` or the "
+          << "`odbc.max_result_bytes` option.";
+  raise_error(message.str());
+}
+
 std::shared_ptr<odbc_connection> odbc_result::connection() const {
   return std::shared_ptr<odbc_connection>(c_);
 }
@@ -71,18 +378,29 @@ std::shared_ptr<nanodbc::result> odbc_result::result() const {
 
 void odbc_result::execute() {
   try {
-    c_->set_current_result(this);
-    s_ = std::make_shared<nanodbc::statement>();
-    if (!this->immediate_) s_->prepare(*c_->connection(), sql_);
+    if (!s_) {
+      s_ = new_statement();
+    }
+    if (!this->immediate_ && !s_->open()) {
+      auto started = result_stats::clock::now();
+      s_->prepare(*c_->connection(), sql_);
+      stats_.prepare += result_stats::since(started);
+      prepared_ = cursor_type_ == SQL_CURSOR_FORWARD_ONLY &&
+                  concurrency_ == SQL_CONCUR_READ_ONLY;
+    }
     if (this->immediate_ || (s_->parameters() == 0)) {
       bound_ = true;
+      auto started = result_stats::clock::now();
       r_ = std::make_shared<nanodbc::result>(
-          this->immediate_ ? s_->execute_direct(*c_->connection(), sql_) :
-          s_->execute());
+          this->immediate_ ?
+          s_->execute_direct(*c_->connection(), sql_, 1, query_timeout()) :
+          s_->execute(1, query_timeout()));
+      stats_.execute += result_stats::since(started);
+      ++stats_.executions;
       num_columns_ = r_->columns();
     }
   } catch (const nanodbc::database_error& e) {
-    if (c_->interruptible_execution_) {
+    if (threaded_) {
       // Executing in a thread away from main.  Signal
       // that we have encountered an error using an exception.
       // Main thread will do resource cleanup, and
@@ -92,17 +410,45 @@ void odbc_result::execute() {
       // Executing on the main thread.  Raise the
       // formatted [R] errpr ourselves, and
       // do resource cleanup.
-      c_->set_current_result(nullptr);
+      c_->release_result(this);
       raise_error(odbc_error(e, sql_, *output_encoder_));
     }
   } catch (...) {
-    if (!c_->interruptible_execution_) {
-      c_->set_current_result(nullptr);
+    if (!threaded_) {
+      c_->release_result(this);
     }
     throw;
   }
 }
 
+std::shared_ptr<nanodbc::statement> odbc_result::new_statement() {
+  const bool default_cursor = cursor_type_ == SQL_CURSOR_FORWARD_ONLY &&
+                              concurrency_ == SQL_CONCUR_READ_ONLY;
+  if (!this->immediate_ && default_cursor) {
+    // Re-use a statement prepared earlier for the same SQL, along with
+    // its parameter descriptions, if the connection caches statements.
+    auto s = c_->cached_statement(sql_);
+    if (s) {
+      return s;
+    }
+  }
+  auto s = std::make_shared<nanodbc::statement>();
+  if (!default_cursor) {
+    // Applied when the statement is opened by `prepare()` or
+    // `execute_direct()`.
+    s->set_attribute(SQL_ATTR_CURSOR_TYPE, cursor_type_);
+    s->set_attribute(SQL_ATTR_CONCURRENCY, concurrency_);
+  }
+  return s;
+}
+
+void odbc_result::cache_statement() {
+  if (prepared_) {
+    prepared_ = false;
+    c_->cache_statement(sql_, s_);
+  }
+}
+
 template<typename T>
 void odbc_result::bind_columns(
     T& obj,
@@ -174,10 +520,44 @@ void odbc_result::describe_parameters(Rcpp::List const& x) {
       Rcpp::as<std::vector<short>>(scale));
 }
 
+size_t odbc_result::param_data::bytes() const {
+  size_t out = 0;
+  for (auto const& column : strings_) {
+    for (auto const& value : column.second) {
+      out += value.size();
+    }
+  }
+  for (auto const& column : raws_) {
+    for (auto const& value : column.second) {
+      out += value.size();
+    }
+  }
+  for (auto const& column : integers_) {
+    out += column.second.size() * sizeof(int);
+  }
+  for (auto const& column : doubles_) {
+    out += column.second.size() * sizeof(double);
+  }
+  for (auto const& column : times_) {
+    out += column.second.size() * sizeof(nanodbc::time);
+  }
+  for (auto const& column : timestamps_) {
+    out += column.second.size() * sizeof(nanodbc::timestamp);
+  }
+  for (auto const& column : timestampoffsets_) {
+    out += column.second.size() * sizeof(nanodbc::timestampoffset);
+  }
+  for (auto const& column : dates_) {
+    out += column.second.size() * sizeof(nanodbc::date);
+  }
+  return out;
+}
+
 void odbc_result::bind_list(
     Rcpp::List const& x, bool use_transaction, size_t batch_rows) {
   complete_ = false;
   rows_fetched_ = 0;
+  positioned_ = false;
   auto types = column_types(x);
   auto ncols = x.size();
 
@@ -191,12 +571,10 @@ void odbc_result::bind_list(
   }
   size_t nrows = get_parameter_rows(x);
   size_t start = 0;
-  std::unique_ptr<nanodbc::transaction> t;
-  if (use_transaction && c_->supports_transactions()) {
-    t = std::unique_ptr<nanodbc::transaction>(
-        new nanodbc::transaction(*c_->connection()));
-  }
+  transaction_scope t(*c_, use_transaction && c_->supports_transactions());
 
+  progress p("Inserting", nrows);
+  double bytes = 0;
   while (start < nrows) {
     size_t end = start + batch_rows > nrows ? nrows : start + batch_rows;
     size_t size = end - start;
@@ -205,16 +583,170 @@ void odbc_result::bind_list(
     for (short col = 0; col < ncols; ++col) {
       bind_columns(*s_, types[col], x, col, start, size, buffers_);
     }
-    r_ = std::make_shared<nanodbc::result>(nanodbc::execute(*s_, size));
+    auto started = result_stats::clock::now();
+    r_ = std::make_shared<nanodbc::result>(s_->execute(size, query_timeout()));
+    stats_.execute += result_stats::since(started);
+    ++stats_.executions;
     num_columns_ = r_->columns();
     start += batch_rows;
+    if (p.enabled()) {
+      bytes += buffers_.bytes();
+      p.update(end, bytes);
+    }
 
     Rcpp::checkUserInterrupt();
   }
-  if (t) {
-    t->commit();
+  t.commit();
+  p.done();
+  bound_ = true;
+  report_stats();
+}
+
+double odbc_result::bind_arrow(
+    ArrowArrayStream* stream,
+    bool use_transaction,
+    size_t batch_rows,
+    std::string const& encoding) {
+  complete_ = false;
+  rows_fetched_ = 0;
+  positioned_ = false;
+
+  arrow_stream_reader reader(stream);
+  auto const& schema = reader.schema();
+  if (std::string(schema.format) != "+s") {
+    Rcpp::stop("Arrow data must be a stream of record batches.");
+  }
+  auto ncols = static_cast<short>(schema.n_children);
+
+  if (s_->parameters() == 0) {
+    Rcpp::stop("Query does not require parameters.");
+  }
+
+  if (ncols != s_->parameters()) {
+    Rcpp::stop(
+        "Query requires '%i' params; '%i' supplied.", s_->parameters(), ncols);
+  }
+  std::unique_ptr<Iconv> encoder;
+  if (!encoding.empty()) {
+    encoder.reset(new Iconv("UTF-8", encoding));
+  }
+  transaction_scope t(*c_, use_transaction && c_->supports_transactions());
+
+  progress p("Inserting", -1);
+  double rows = 0;
+  double bytes = 0;
+  while (reader.next()) {
+    auto const& batch = reader.batch();
+    size_t nrows = batch.length;
+    for (size_t start = 0; start < nrows; start += batch_rows) {
+      size_t size = std::min(batch_rows, nrows - start);
+      clear_buffers();
+
+      for (short col = 0; col < ncols; ++col) {
+        bind_arrow_column(
+            *schema.children[col],
+            *batch.children[col],
+            col,
+            batch.offset + start,
+            size,
+            encoder.get());
+      }
+      auto started = result_stats::clock::now();
+      r_ = std::make_shared<nanodbc::result>(
+          s_->execute(size, query_timeout()));
+      stats_.execute += result_stats::since(started);
+      ++stats_.executions;
+      num_columns_ = r_->columns();
+      rows += size;
+      if (p.enabled()) {
+        bytes += buffers_.bytes();
+        p.update(rows, bytes);
+      }
+
+      Rcpp::checkUserInterrupt();
+    }
+  }
+  t.commit();
+  p.done();
+  bound_ = true;
+  report_stats();
+  return rows;
+}
+
+double odbc_result::import_csv(
+    std::string const& path,
+    csv_options const& options,
+    size_t batch_rows,
+    std::string const& encoding) {
+  complete_ = false;
+  rows_fetched_ = 0;
+  positioned_ = false;
+
+  short ncols = s_->parameters();
+  if (ncols == 0) {
+    Rcpp::stop("Query does not require parameters.");
+  }
+  // How fields are converted is decided once, from the described types.
+  std::vector<short> types;
+  for (short col = 0; col < ncols; ++col) {
+    short type = SQL_VARCHAR;
+    try {
+      type = s_->parameter_type(col);
+    } catch (const nanodbc::database_error&) {
+      // Drivers without SQLDescribeParam convert text themselves.
+    }
+    types.push_back(type);
+  }
+  std::unique_ptr<Iconv> encoder;
+  if (!encoding.empty()) {
+    encoder.reset(new Iconv("UTF-8", encoding));
+  }
+
+  csv_reader reader(path, options.delimiter, ncols);
+  csv_chunk chunk;
+  csv_chunk next;
+  if (options.header) {
+    reader.read(1, chunk);
   }
+  bool more = reader.read(batch_rows, chunk);
+
+  transaction_scope t(*c_, c_->supports_transactions());
+
+  progress p("Importing", -1);
+  double rows = 0;
+  double bytes = 0;
+  while (more) {
+    auto parsed = execution_pool::instance().submit(
+        [&]() { more = reader.read(batch_rows, next); });
+    try {
+      clear_buffers();
+      for (short col = 0; col < ncols; ++col) {
+        bind_csv_column(chunk, col, types[col], options.na, encoder.get());
+      }
+      auto started = result_stats::clock::now();
+      r_ = std::make_shared<nanodbc::result>(
+          s_->execute(chunk.rows(), query_timeout()));
+      stats_.execute += result_stats::since(started);
+      ++stats_.executions;
+      num_columns_ = r_->columns();
+      rows += chunk.rows();
+      bytes += chunk.data.size();
+      p.update(rows, bytes);
+    } catch (...) {
+      // `reader` and `next` must outlive the parsing task.
+      parsed.wait();
+      throw;
+    }
+    parsed.get();
+    std::swap(chunk, next);
+
+    Rcpp::checkUserInterrupt();
+  }
+  t.commit();
+  p.done();
   bound_ = true;
+  report_stats();
+  return rows;
 }
 
 Rcpp::DataFrame odbc_result::fetch(int n_max) {
@@ -226,13 +758,164 @@ Rcpp::DataFrame odbc_result::fetch(int n_max) {
   }
   unbind_if_needed();
   try {
-    return result_to_dataframe(*r_, n_max);
+    auto out = result_to_dataframe(*r_, n_max);
+    report_stats();
+    return out;
+  } catch (const nanodbc::database_error&) {
+    c_->release_result(this);
+    raise_if_timed_out();
+    throw;
   } catch (...) {
-    c_->set_current_result(nullptr);
+    c_->release_result(this);
     throw;
   }
 }
 
+void odbc_result::fetch_arrow(
+    ArrowArrayStream* out, int n_max, size_t batch_rows) {
+  if (!bound_) {
+    Rcpp::stop("Query needs to be bound before fetching");
+  }
+  std::unique_ptr<arrow_batches> batches;
+  if (num_columns_ == 0) {
+    batches.reset(new arrow_batches({}));
+    std::vector<arrow_column_builder> none;
+    batches->push_back(none, 0);
+  } else {
+    unbind_if_needed();
+    try {
+      batches = result_to_arrow(*r_, n_max, batch_rows);
+      report_stats();
+    } catch (const nanodbc::database_error&) {
+      c_->release_result(this);
+      raise_if_timed_out();
+      throw;
+    } catch (...) {
+      c_->release_result(this);
+      throw;
+    }
+  }
+  arrow_batches::export_stream(batches.release(), out);
+}
+
+double odbc_result::export_csv(
+    std::string const& path, csv_options const& options, size_t batch_rows) {
+  if (!bound_) {
+    Rcpp::stop("Query needs to be bound before fetching");
+  }
+  if (num_columns_ == 0) {
+    Rcpp::stop("Query does not return a result set.");
+  }
+  unbind_if_needed();
+  try {
+    std::unique_ptr<csv_writer> writer;
+    double rows = 0;
+    do {
+      auto batches = result_to_arrow(*r_, batch_rows, batch_rows);
+      if (!writer) {
+        writer.reset(new csv_writer(path, batches->fields(), options));
+      }
+      ArrowArray batch;
+      while (batches->pop_front(&batch)) {
+        rows += batch.length;
+        writer->write(&batch);
+      }
+      report_stats();
+    } while (!complete_);
+    writer->close();
+    return rows;
+  } catch (const nanodbc::database_error&) {
+    c_->release_result(this);
+    raise_if_timed_out();
+    throw;
+  } catch (...) {
+    c_->release_result(this);
+    throw;
+  }
+}
+
+void odbc_result::seek(long offset) {
+  if (!bound_) {
+    Rcpp::stop("Query needs to be bound before fetching");
+  }
+  if (num_columns_ == 0) {
+    return;
+  }
+  if (cursor_type_ == SQL_CURSOR_FORWARD_ONLY) {
+    raise_error(
+        "`offset` requires a scrollable cursor; use `dbSendQuery()` with a "
+        "`cursor` other than \"forward_only\".");
+  }
+  unbind_if_needed();
+  try {
+    // SQL_FETCH_ABSOLUTE counts rows from 1.
+    auto started = result_stats::clock::now();
+    complete_ = !r_->move(offset + 1);
+    stats_.fetch += result_stats::since(started);
+    ++stats_.fetch_calls;
+  } catch (const nanodbc::database_error& e) {
+    raise_error(odbc_error(e, "", *output_encoder_));
+  }
+  positioned_ = true;
+}
+
+void odbc_result::select_columns(std::vector<std::string> const& names) {
+  if (num_columns_ == 0) {
+    return;
+  }
+  auto all_names = column_names(*r_);
+  std::vector<short> columns;
+  columns.reserve(names.size());
+  for (auto const& name : names) {
+    auto it = std::find(all_names.begin(), all_names.end(), name);
+    if (it == all_names.end()) {
+      raise_error("Column `" + name + "` is not in the result set.");
+    }
+    short column = it - all_names.begin();
+    if (std::find(columns.begin(), columns.end(), column) != columns.end()) {
+      raise_error("Column `" + name + "` is selected more than once.");
+    }
+    columns.push_back(column);
+  }
+
+  if (columns == selected_columns_) {
+    return;
+  }
+  // Skipped columns are unbound below and cannot be bound again.
+  if (rows_fetched_ > 0 || !selected_columns_.empty()) {
+    raise_error(
+        "Can't change the selected `columns` of a result once set.");
+  }
+  selected_columns_ = columns;
+
+  try {
+    for (short i = 0; i < num_columns_; ++i) {
+      if (!is_selected(i)) {
+        r_->unbind(i);
+      }
+    }
+  } catch (const nanodbc::database_error& e) {
+    raise_error(odbc_error(e, sql_, *output_encoder_));
+  }
+}
+
+bool odbc_result::is_selected(short column) const {
+  return selected_columns_.empty() ||
+         std::find(
+             selected_columns_.begin(), selected_columns_.end(), column) !=
+             selected_columns_.end();
+}
+
+std::vector<short> odbc_result::output_columns() const {
+  std::vector<short> columns = selected_columns_;
+  if (columns.empty()) {
+    for (short i = 0; i < num_columns_; ++i) {
+      columns.push_back(i);
+    }
+  }
+  return columns;
+}
+
 void odbc_result::unbind_if_needed() {
   bool found_unbound = false;
 
@@ -240,6 +923,11 @@ void odbc_result::unbind_if_needed() {
     return;
   try {
     for (short i = 0; i < num_columns_; ++i) {
+      // Skipped columns are never read, so they do not constrain the order
+      // in which the remaining columns are retrieved.
+      if (!is_selected(i)) {
+        continue;
+      }
       found_unbound = found_unbound || !r_->is_bound(i);
       if (found_unbound) {
         r_->unbind(i);
@@ -262,9 +950,22 @@ bool odbc_result::complete() {
 bool odbc_result::active() { return c_->is_current_result(this); }
 
 odbc_result::~odbc_result() {
+  if (pending_.valid()) {
+    // Still executing on another thread, which may not outlive us.
+    try {
+      if (!ready()) {
+        s_->cancel();
+      }
+    } catch (...) {
+    }
+    pending_.wait();
+    if (c_->pending_result_ == this) {
+      c_->pending_result_ = nullptr;
+    }
+  }
   if (c_ != nullptr && active()) {
     try {
-      c_->set_current_result(nullptr);
+      c_->release_result(this);
     } catch (...) {
       // SQLCancel may throw an error.
       // Regardless, as this object is
@@ -272,13 +973,22 @@ odbc_result::~odbc_result() {
       // make sure the connection is not
       // holding onto an invalid reference
       c_->current_result_ = nullptr;
+      c_->active_results_.erase(this);
     };
   }
+  // A statement shared with the connection's statement cache outlives this
+  // result; release the cursor and the bindings to our buffers.
+  if (s_ && s_.use_count() > 1) {
+    r_.reset();
+    s_->close_cursor();
+  }
 }
 
 void odbc_result::clear_buffers() {
   buffers_.strings_.clear();
   buffers_.raws_.clear();
+  buffers_.integers_.clear();
+  buffers_.doubles_.clear();
   buffers_.times_.clear();
   buffers_.timestamps_.clear();
   buffers_.timestampoffsets_.clear();
@@ -404,6 +1114,26 @@ void odbc_result::bind_raw(
       column, buffers.raws_[column], reinterpret_cast<bool*>(buffers.nulls_[column].data()));
 }
 
+template <typename T>
+void odbc_result::datetime_precision(
+    T& obj,
+    short column,
+    unsigned long long& factor,
+    unsigned long long& pad) {
+  short precision = 3;
+  try {
+    precision = obj.parameter_scale(column);
+  } catch (const nanodbc::database_error& e) {
+    raise_warning("Unable to discern datetime precision. Using default (3).");
+  };
+  // Sanity scrub
+  precision = std::min<short>(precision, 7);
+  factor = std::pow(10, precision);
+  // The fraction field is expressed in billionths of
+  // a second.
+  pad = std::pow(10, 9 - precision);
+}
+
 template<typename T, typename SourceType>
 void odbc_result::bind_datetime(
     T& obj,
@@ -422,18 +1152,8 @@ void odbc_result::bind_datetime(
 
   nanodbc::timestampoffset tso;
   nanodbc::timestamp& ts = tso.stamp;
-  short precision = 3;
-  try {
-    precision = obj.parameter_scale(column);
-  } catch (const nanodbc::database_error& e) {
-    raise_warning("Unable to discern datetime precision. Using default (3).");
-  };
-  // Sanity scrub
-  precision = std::min<short>(precision, 7);
-  unsigned long long prec_adj = std::pow(10, precision);
-  // The fraction field is expressed in billionths of
-  // a second.
-  unsigned long long pad = std::pow(10, 9 - precision);
+  unsigned long long prec_adj, pad;
+  datetime_precision(obj, column, prec_adj, pad);
   if (bind_tso) {
     buffers.timestampoffsets_[column].reserve(size);
   } else {
@@ -499,57 +1219,488 @@ void odbc_result::bind_date(
       reinterpret_cast<bool*>(buffers.nulls_[column].data()));
 }
 
-template<typename T>
-void odbc_result::bind_time(
-    T& obj,
-    Rcpp::List const& data,
+template<typename T>
+void odbc_result::bind_time(
+    T& obj,
+    Rcpp::List const& data,
+    short column,
+    size_t start,
+    size_t size,
+    param_data& buffers) {
+
+  buffers.nulls_[column] = std::vector<uint8_t>(size, false);
+  auto d = REAL(data[column]);
+
+  nanodbc::time ts;
+  buffers.times_[column].reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    auto value = d[start + i];
+    if (ISNA(value)) {
+      buffers.nulls_[column][i] = true;
+    } else {
+      ts = as_time(value);
+    }
+    buffers.times_[column].push_back(ts);
+  }
+  obj.bind(
+      column,
+      buffers.times_[column].data(),
+      size,
+      reinterpret_cast<bool*>(buffers.nulls_[column].data()));
+}
+
+template<typename T>
+void odbc_result::bind_df(
+    T& obj,
+    Rcpp::List const& data,
+    short column,
+    size_t start, /* ignored */
+    size_t size,  /* ignored */
+    param_data& buffers) {
+
+  const Rcpp::List& df = data[column];
+  auto types = column_types(df);
+  auto ncols = df.size();
+  size_t nrows = Rf_length(df[0]);
+  auto param = nanodbc::table_valued_parameter(*s_, column, nrows);
+
+  for (short col = 0; col < ncols; ++col) {
+    bind_columns(param, types[col], df, col, 0, nrows, tvp_buffers_[column]);
+  }
+  param.close();
+
+  return;
+}
+
+void odbc_result::bind_arrow_column(
+    ArrowSchema const& schema,
+    ArrowArray const& array,
+    short column,
+    size_t start,
+    size_t size,
+    Iconv* encoder) {
+  std::string format = schema.format;
+  if (schema.dictionary != nullptr) {
+    bind_arrow_dictionary(schema, array, column, start, size, encoder);
+  } else if (format == "b") {
+    bind_arrow_logical(array, column, start, size);
+  } else if (format == "c") {
+    bind_arrow_integer<int8_t>(array, column, start, size);
+  } else if (format == "s") {
+    bind_arrow_integer<int16_t>(array, column, start, size);
+  } else if (format == "i") {
+    bind_arrow_fixed<int>(array, column, start, size);
+  } else if (format == "l") {
+    bind_arrow_fixed<long long>(array, column, start, size);
+  } else if (format == "f") {
+    bind_arrow_fixed<float>(array, column, start, size);
+  } else if (format == "g") {
+    bind_arrow_fixed<double>(array, column, start, size);
+  } else if (format == "u") {
+    bind_arrow_string<int32_t>(array, column, start, size, encoder);
+  } else if (format == "U") {
+    bind_arrow_string<int64_t>(array, column, start, size, encoder);
+  } else if (format == "z") {
+    bind_arrow_raw<int32_t>(array, column, start, size);
+  } else if (format == "Z") {
+    bind_arrow_raw<int64_t>(array, column, start, size);
+  } else if (format == "tdD") {
+    bind_arrow_date<int32_t>(array, column, start, size, seconds_in_day_);
+  } else if (format == "tdm") {
+    bind_arrow_date<int64_t>(array, column, start, size, 1e-3);
+  } else if (format == "tts") {
+    bind_arrow_time<int32_t>(array, column, start, size, 1);
+  } else if (format == "ttm") {
+    bind_arrow_time<int32_t>(array, column, start, size, 1e-3);
+  } else if (format == "ttu") {
+    bind_arrow_time<int64_t>(array, column, start, size, 1e-6);
+  } else if (format == "ttn") {
+    bind_arrow_time<int64_t>(array, column, start, size, 1e-9);
+  } else if (
+      format.size() >= 4 && format.compare(0, 2, "ts") == 0 &&
+      format[3] == ':') {
+    double unit = 0;
+    switch (format[2]) {
+    case 's':
+      unit = 1;
+      break;
+    case 'm':
+      unit = 1e-3;
+      break;
+    case 'u':
+      unit = 1e-6;
+      break;
+    case 'n':
+      unit = 1e-9;
+      break;
+    }
+    if (unit == 0) {
+      Rcpp::stop(
+          "Arrow type '%s' of parameter %i is not supported.",
+          format,
+          column + 1);
+    }
+    bind_arrow_datetime(array, column, start, size, unit, format.size() > 4);
+  } else {
+    Rcpp::stop(
+        "Arrow type '%s' of parameter %i is not supported.", format, column + 1);
+  }
+}
+
+bool* odbc_result::arrow_nulls(
+    ArrowArray const& array, short column, size_t start, size_t size) {
+  if (array.buffers[0] == nullptr || array.null_count == 0) {
+    return nullptr;
+  }
+  auto& nulls = buffers_.nulls_[column];
+  nulls.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    nulls[i] = !arrow_is_valid(array, start + i);
+  }
+  return reinterpret_cast<bool*>(nulls.data());
+}
+
+template <typename T>
+void odbc_result::bind_arrow_fixed(
+    ArrowArray const& array, short column, size_t start, size_t size) {
+  auto values = static_cast<const T*>(array.buffers[1]) + array.offset + start;
+  s_->bind(column, values, size, arrow_nulls(array, column, start, size));
+}
+
+template <typename T>
+void odbc_result::bind_arrow_integer(
+    ArrowArray const& array, short column, size_t start, size_t size) {
+  auto values = static_cast<const T*>(array.buffers[1]) + array.offset + start;
+  auto& integers = buffers_.integers_[column];
+  integers.assign(values, values + size);
+  s_->bind(
+      column,
+      integers.data(),
+      size,
+      arrow_nulls(array, column, start, size));
+}
+
+void odbc_result::bind_arrow_logical(
+    ArrowArray const& array, short column, size_t start, size_t size) {
+  auto bits = static_cast<const uint8_t*>(array.buffers[1]);
+  auto& integers = buffers_.integers_[column];
+  integers.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    size_t bit = array.offset + start + i;
+    integers[i] = (bits[bit / 8] >> (bit % 8)) & 1;
+  }
+  s_->bind(
+      column,
+      integers.data(),
+      size,
+      arrow_nulls(array, column, start, size));
+}
+
+template <typename Offset>
+void odbc_result::bind_arrow_string(
+    ArrowArray const& array,
+    short column,
+    size_t start,
+    size_t size,
+    Iconv* encoder) {
+  auto offsets =
+      static_cast<const Offset*>(array.buffers[1]) + array.offset + start;
+  auto data = static_cast<const char*>(array.buffers[2]);
+  bool* nulls = arrow_nulls(array, column, start, size);
+  auto& strings = buffers_.strings_[column];
+  strings.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (nulls && nulls[i]) {
+      strings.emplace_back();
+    } else {
+      strings.push_back(
+          encode_string(data + offsets[i], data + offsets[i + 1], encoder));
+    }
+  }
+  s_->bind_strings(column, strings, nulls);
+}
+
+template <typename Offset>
+void odbc_result::bind_arrow_raw(
+    ArrowArray const& array, short column, size_t start, size_t size) {
+  auto offsets =
+      static_cast<const Offset*>(array.buffers[1]) + array.offset + start;
+  auto data = static_cast<const uint8_t*>(array.buffers[2]);
+  bool* nulls = arrow_nulls(array, column, start, size);
+  auto& raws = buffers_.raws_[column];
+  raws.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (nulls && nulls[i]) {
+      raws.emplace_back();
+    } else {
+      raws.emplace_back(data + offsets[i], data + offsets[i + 1]);
+    }
+  }
+  s_->bind(column, raws, nulls);
+}
+
+void odbc_result::bind_arrow_dictionary(
+    ArrowSchema const& schema,
+    ArrowArray const& array,
+    short column,
+    size_t start,
+    size_t size,
+    Iconv* encoder) {
+  std::string index_format = schema.format;
+  std::string value_format = schema.dictionary->format;
+  if (index_format.size() != 1 ||
+      std::string("csil").find(index_format[0]) == std::string::npos ||
+      value_format != "u" || array.dictionary == nullptr) {
+    Rcpp::stop(
+        "Only dictionaries of strings are supported (parameter %i).",
+        column + 1);
+  }
+  auto const& dictionary = *array.dictionary;
+  auto offsets =
+      static_cast<const int32_t*>(dictionary.buffers[1]) + dictionary.offset;
+  auto data = static_cast<const char*>(dictionary.buffers[2]);
+  bool* nulls = arrow_nulls(array, column, start, size);
+  auto& strings = buffers_.strings_[column];
+  strings.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    if (nulls && nulls[i]) {
+      strings.emplace_back();
+      continue;
+    }
+    auto j = arrow_index(
+        index_format[0], array.buffers[1], array.offset + start + i);
+    strings.push_back(
+        encode_string(data + offsets[j], data + offsets[j + 1], encoder));
+  }
+  s_->bind_strings(column, strings, nulls);
+}
+
+template <typename T>
+void odbc_result::bind_arrow_date(
+    ArrowArray const& array,
+    short column,
+    size_t start,
+    size_t size,
+    double unit) {
+  auto values = static_cast<const T*>(array.buffers[1]) + array.offset + start;
+  bool* nulls = arrow_nulls(array, column, start, size);
+  auto& dates = buffers_.dates_[column];
+  dates.reserve(size);
+  nanodbc::date dt{};
+  for (size_t i = 0; i < size; ++i) {
+    if (!(nulls && nulls[i])) {
+      dt = as_date(values[i] * unit);
+    }
+    dates.push_back(dt);
+  }
+  s_->bind(column, dates.data(), size, nulls);
+}
+
+template <typename T>
+void odbc_result::bind_arrow_time(
+    ArrowArray const& array,
+    short column,
+    size_t start,
+    size_t size,
+    double unit) {
+  auto values = static_cast<const T*>(array.buffers[1]) + array.offset + start;
+  bool* nulls = arrow_nulls(array, column, start, size);
+  auto& times = buffers_.times_[column];
+  times.reserve(size);
+  nanodbc::time tm{};
+  for (size_t i = 0; i < size; ++i) {
+    if (!(nulls && nulls[i])) {
+      tm = as_time(values[i] * unit);
+    }
+    times.push_back(tm);
+  }
+  s_->bind(column, times.data(), size, nulls);
+}
+
+void odbc_result::bind_arrow_datetime(
+    ArrowArray const& array,
     short column,
     size_t start,
     size_t size,
-    param_data& buffers) {
-
-  buffers.nulls_[column] = std::vector<uint8_t>(size, false);
-  auto d = REAL(data[column]);
-
-  nanodbc::time ts;
-  buffers.times_[column].reserve(size);
+    double unit,
+    bool instant) {
+  auto values =
+      static_cast<const int64_t*>(array.buffers[1]) + array.offset + start;
+  bool* nulls = arrow_nulls(array, column, start, size);
+  const cctz::time_zone tz = instant ? c_->timezone() : cctz::utc_time_zone();
+  unsigned long long prec_adj, pad;
+  datetime_precision(*s_, column, prec_adj, pad);
+
+  auto& timestamps = buffers_.timestamps_[column];
+  timestamps.reserve(size);
+  nanodbc::timestamp ts{};
   for (size_t i = 0; i < size; ++i) {
-    auto value = d[start + i];
-    if (ISNA(value)) {
-      buffers.nulls_[column][i] = true;
-    } else {
-      ts = as_time(value);
+    if (!(nulls && nulls[i])) {
+      as_timestamp(values[i] * unit, prec_adj, pad, tz, ts);
     }
-    buffers.times_[column].push_back(ts);
+    timestamps.push_back(ts);
   }
-  obj.bind(
-      column,
-      buffers.times_[column].data(),
-      size,
-      reinterpret_cast<bool*>(buffers.nulls_[column].data()));
+  s_->bind(column, timestamps.data(), size, nulls);
 }
 
-template<typename T>
-void odbc_result::bind_df(
-    T& obj,
-    Rcpp::List const& data,
+void odbc_result::bind_csv_column(
+    csv_chunk const& chunk,
     short column,
-    size_t start, /* ignored */
-    size_t size,  /* ignored */
-    param_data& buffers) {
-
-  const Rcpp::List& df = data[column];
-  auto types = column_types(df);
-  auto ncols = df.size();
-  size_t nrows = Rf_length(df[0]);
-  auto param = nanodbc::table_valued_parameter(*s_, column, nrows);
-
-  for (short col = 0; col < ncols; ++col) {
-    bind_columns(param, types[col], df, col, 0, nrows, tvp_buffers_[column]);
+    short sql_type,
+    std::string const& na,
+    Iconv* encoder) {
+  size_t size = chunk.rows();
+  auto& nulls = buffers_.nulls_[column];
+  nulls.assign(size, false);
+  for (size_t i = 0; i < size; ++i) {
+    auto begin = chunk.begin(i, column);
+    auto end = chunk.end(i, column);
+    nulls[i] = !chunk.is_quoted(i, column) &&
+               static_cast<size_t>(end - begin) == na.size() &&
+               std::equal(begin, end, na.begin());
   }
-  param.close();
+  auto null_flags = reinterpret_cast<bool*>(nulls.data());
+  auto fail = [&](size_t i, const char* type) {
+    Rcpp::stop(
+        "Can't convert '%s' in line %i, field %i to %s.",
+        std::string(chunk.begin(i, column), chunk.end(i, column)),
+        static_cast<int>(chunk.lines[i]),
+        column + 1,
+        type);
+  };
 
-  return;
+  switch (sql_type) {
+  case SQL_BIT:
+  case SQL_TINYINT:
+  case SQL_SMALLINT:
+  case SQL_INTEGER: {
+    auto& values = buffers_.integers_[column];
+    values.assign(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+      if (!nulls[i] &&
+          !parse_integer(
+              chunk.begin(i, column),
+              chunk.end(i, column),
+              sql_type == SQL_BIT,
+              values[i])) {
+        fail(i, "an integer");
+      }
+    }
+    s_->bind(column, values.data(), size, null_flags);
+    break;
+  }
+  case SQL_REAL:
+  case SQL_FLOAT:
+  case SQL_DOUBLE: {
+    auto& values = buffers_.doubles_[column];
+    values.assign(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+      if (!nulls[i] &&
+          !parse_double(
+              chunk.begin(i, column), chunk.end(i, column), values[i])) {
+        fail(i, "a number");
+      }
+    }
+    s_->bind(column, values.data(), size, null_flags);
+    break;
+  }
+  case SQL_TYPE_DATE: {
+    auto& dates = buffers_.dates_[column];
+    dates.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      nanodbc::date dt{};
+      if (!nulls[i]) {
+        auto p = chunk.begin(i, column);
+        auto end = chunk.end(i, column);
+        int y, m, d;
+        if (!parse_date(p, end, y, m, d) || p != end) {
+          fail(i, "a date");
+        }
+        dt.year = y;
+        dt.month = m;
+        dt.day = d;
+      }
+      dates.push_back(dt);
+    }
+    s_->bind(column, dates.data(), size, null_flags);
+    break;
+  }
+  case SQL_TYPE_TIME:
+  case SQL_SS_TIME2: {
+    auto& times = buffers_.times_[column];
+    times.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      nanodbc::time tm{};
+      if (!nulls[i]) {
+        auto p = chunk.begin(i, column);
+        auto end = chunk.end(i, column);
+        int h, m, sec;
+        double frac;
+        if (!parse_time(p, end, h, m, sec, frac) || p != end) {
+          fail(i, "a time");
+        }
+        tm.hour = h;
+        tm.min = m;
+        tm.sec = sec;
+      }
+      times.push_back(tm);
+    }
+    s_->bind(column, times.data(), size, null_flags);
+    break;
+  }
+  case SQL_TYPE_TIMESTAMP: {
+    unsigned long long prec_adj, pad;
+    datetime_precision(*s_, column, prec_adj, pad);
+    auto& timestamps = buffers_.timestamps_[column];
+    timestamps.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      nanodbc::timestamp ts{};
+      if (!nulls[i]) {
+        auto p = chunk.begin(i, column);
+        auto end = chunk.end(i, column);
+        int y, mo, d, h = 0, mi = 0, sec = 0, offset = 0;
+        double frac = 0;
+        bool zoned = false;
+        bool ok = parse_date(p, end, y, mo, d);
+        if (ok && p != end) {
+          ok = (parse_char(p, end, 'T') || parse_char(p, end, ' ')) &&
+               parse_time(p, end, h, mi, sec, frac);
+          zoned = ok && p != end;
+          ok = ok && (!zoned || parse_offset(p, end, offset));
+        }
+        if (!ok || p != end) {
+          fail(i, "a timestamp");
+        }
+        // Timestamps with an offset are instants; others are bound as
+        // they are.
+        auto utc = cctz::convert(
+            cctz::civil_second(y, mo, d, h, mi, sec), cctz::utc_time_zone());
+        double value = utc.time_since_epoch().count() - offset + frac;
+        as_timestamp(
+            value,
+            prec_adj,
+            pad,
+            zoned ? c_->timezone() : cctz::utc_time_zone(),
+            ts);
+      }
+      timestamps.push_back(ts);
+    }
+    s_->bind(column, timestamps.data(), size, null_flags);
+    break;
+  }
+  default: {
+    auto& strings = buffers_.strings_[column];
+    strings.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      strings.push_back(
+          nulls[i] ? std::string()
+                   : encode_string(
+                         chunk.begin(i, column), chunk.end(i, column), encoder));
+    }
+    s_->bind_strings(column, strings, null_flags);
+    break;
+  }
+  }
 }
 
 std::vector<std::string> odbc_result::column_names(nanodbc::result const& r) {
@@ -910,85 +2061,238 @@ bool odbc_result::nextResultSet(nanodbc::result& r) {
 }
 
 Rcpp::List odbc_result::result_to_dataframe(nanodbc::result& r, int n_max) {
+  // Whatever is not spent fetching or allocating is spent decoding.
+  auto started = result_stats::clock::now();
+  const double fetch_before = stats_.fetch;
+  const double allocate_before = stats_.allocate;
+  const size_t get_data_calls = r.get_data_calls();
+  const size_t get_data_bytes = r.get_data_bytes();
+  const size_t iconv_calls = output_encoder_->conversions();
+  const size_t iconv_bytes = output_encoder_->bytes();
+  const double iconv = output_encoder_->seconds();
+
+  auto all_types = column_types(r);
+  auto all_names = column_names(r);
+
+  // Output columns, in the order requested by `select_columns`.
+  std::vector<short> columns = output_columns();
+  std::vector<r_type> types;
+  std::vector<std::string> names;
+  types.reserve(columns.size());
+  names.reserve(columns.size());
+  for (short column : columns) {
+    types.push_back(all_types[column]);
+    names.push_back(all_names[column]);
+  }
 
-  auto types = column_types(r);
+  // Allocations are counted against the connection's `max_result_bytes`,
+  // or the `odbc.max_result_bytes` option when it was left at `NA`, and
+  // the columns grown no further than it allows.
+  double limit = c_->max_result_bytes();
+  if (std::isnan(limit)) {
+    limit = option_max_result_bytes();
+  }
+  const bool limited = limit > 0 && std::isfinite(limit);
+  double row_bytes = 0;
+  for (r_type type : types) {
+    row_bytes += r_element_bytes(type);
+  }
 
   int n = (n_max < 0) ? 100 : n_max;
+  if (limited && n * row_bytes > limit) {
+    n = std::min(n, 100);
+  }
 
-  Rcpp::List out = create_dataframe(types, column_names(r), n);
+  auto allocated = result_stats::clock::now();
+  Rcpp::List out = create_dataframe(types, names, n);
+  stats_.allocate += result_stats::since(allocated);
+  ++stats_.allocations;
+  result_bytes_ = r_vector_bytes(0) * types.size() + n * row_bytes;
   int row = 0;
 
-  if (rows_fetched_ == 0 && n > 0) {
+  auto plan = decode_plan(columns, types, r);
+  utils::cancel_timer timer(deadline_after(timeout_), [this]() {
+    timed_out_ = true;
+    s_->cancel();
+  });
+
+  // Most drivers don't know the row count of a query, so SQLRowCount is
+  // only asked for the sake of a progress bar.
+  double total = n_max;
+  if (n_max < 0 && progress::wanted()) {
+    try {
+      long expected = r.affected_rows();
+      total = expected > 0 ? expected - static_cast<double>(rows_fetched_) : -1;
+    } catch (const nanodbc::database_error&) {
+    }
+  }
+  progress p("Fetching", total);
+
+  if (!positioned_ && n > 0) {
+    auto fetched = result_stats::clock::now();
     complete_ = !r.next() && !nextResultSet(r);
+    stats_.fetch += result_stats::since(fetched);
+    ++stats_.fetch_calls;
+    positioned_ = true;
   }
 
   while (!complete_) {
     if (row >= n) {
-      if (n_max < 0) {
-        n *= 2;
-        out = resize_dataframe(out, n);
-      } else {
+      if (n_max >= 0 && n >= n_max) {
         break;
       }
+      int grown = (n_max < 0) ? n * 2 : std::min(n * 2, n_max);
+      if (limited) {
+        double room = std::floor((limit - result_bytes_) / row_bytes);
+        if (room < 1) {
+          raise_memory_limit(limit, row);
+        }
+        grown = static_cast<int>(std::min<double>(grown, n + room));
+      }
+      result_bytes_ += (grown - n) * row_bytes;
+      n = grown;
+      allocated = result_stats::clock::now();
+      out = resize_dataframe(out, n);
+      stats_.allocate += result_stats::since(allocated);
+      ++stats_.resizes;
+    }
+    if (rows_fetched_ % result_stats::decode_sample_rows == 0) {
+      for (auto const& step : plan) {
+        auto decoded = result_stats::clock::now();
+        (this->*step.assign)(VECTOR_ELT(out, step.target), row, step.column, r);
+        stats_.decode_by_type[types[step.target]] +=
+            result_stats::since(decoded) * result_stats::decode_sample_rows;
+      }
+    } else {
+      for (auto const& step : plan) {
+        (this->*step.assign)(VECTOR_ELT(out, step.target), row, step.column, r);
+      }
     }
-    for (size_t col = 0; col < types.size(); ++col) {
-      switch (types[col]) {
-      case date_int_t:
-      case date_double_t:
-        assign_date(out, row, col, r);
-        break;
-      case datetime_double_t:
-      case datetime_int_t:
-        assign_datetime(out, row, col, r);
-        break;
-      case odbc::double_t:
-        assign_double(out, row, col, r);
-        break;
-      case integer_t:
-        assign_integer(out, row, col, r);
-        break;
-      case integer64_t:
-        assign_integer64(out, row, col, r);
-        break;
-      case odbc::time_t:
-        assign_time(out, row, col, r);
-        break;
-      case string_t:
-        assign_string(out, row, col, r);
-        break;
-      case ustring_t:
-        assign_ustring(out, row, col, r);
-        break;
-      case logical_t:
-        assign_logical(out, row, col, r);
-        break;
-      case raw_t:
-        assign_raw(out, row, col, r);
-        break;
-      default:
-        signal_unknown_field_type(types[col], r.column_name(col));
-        break;
-      } // switch (types[col])
-    } // for (size_t col = 0,... )
 
+    auto fetched = result_stats::clock::now();
     complete_ = !r.next();
+    stats_.fetch += result_stats::since(fetched);
+    ++stats_.fetch_calls;
     ++row;
     ++rows_fetched_;
+    // Bytes decoded so far: the rows filled and the strings and raw vectors
+    // in them, not the capacity allocated ahead of them.
+    p.update(row, result_bytes_ - (n - row) * row_bytes);
+    if (limited && result_bytes_ > limit) {
+      raise_memory_limit(limit, row);
+    }
     if (rows_fetched_ % 16384 == 0) {
       Rcpp::checkUserInterrupt();
     }
+    if (timed_out_) {
+      raise_timeout();
+    }
     complete_ = complete_ && !nextResultSet(r);
   } // while ( !complete_ )
 
   // Resize if needed
   if (row < n) {
+    allocated = result_stats::clock::now();
     out = resize_dataframe(out, row);
+    stats_.allocate += result_stats::since(allocated);
+    ++stats_.resizes;
   }
+  p.done();
 
   add_classes(out, types);
+
+  stats_.rows += row;
+  stats_.get_data_calls += r.get_data_calls() - get_data_calls;
+  stats_.get_data_bytes += r.get_data_bytes() - get_data_bytes;
+  stats_.iconv_calls += output_encoder_->conversions() - iconv_calls;
+  stats_.iconv_bytes += output_encoder_->bytes() - iconv_bytes;
+  stats_.iconv += output_encoder_->seconds() - iconv;
+  stats_.decode += result_stats::since(started) -
+                   (stats_.fetch - fetch_before) -
+                   (stats_.allocate - allocate_before);
   return out;
 }
 
+std::vector<odbc_result::decode_step> odbc_result::decode_plan(
+    std::vector<short> const& columns,
+    std::vector<r_type> const& types,
+    nanodbc::result const& r) {
+  std::vector<decode_step> plan;
+  plan.reserve(types.size());
+  for (size_t col = 0; col < types.size(); ++col) {
+    assign_fn assign;
+    // String, date and raw columns the driver reports as NOT NULL skip the
+    // null indicator check before each value is read, but not the one after
+    // it.  Numeric columns are always read with `safe_get`.
+    const bool nullable = r.column_nullable(columns[col]);
+    switch (types[col]) {
+    case date_int_t:
+    case date_double_t:
+      assign =
+          nullable ? &odbc_result::assign_date<true>
+                   : &odbc_result::assign_date<false>;
+      break;
+    case datetime_double_t:
+    case datetime_int_t:
+      assign =
+          nullable ? &odbc_result::assign_datetime<true>
+                   : &odbc_result::assign_datetime<false>;
+      break;
+    case odbc::double_t:
+      assign = &odbc_result::assign_double;
+      break;
+    case integer_t:
+      assign = &odbc_result::assign_integer;
+      break;
+    case integer64_t:
+      assign = &odbc_result::assign_integer64;
+      break;
+    case odbc::time_t:
+      assign =
+          nullable ? &odbc_result::assign_time<true>
+                   : &odbc_result::assign_time<false>;
+      break;
+    case string_t:
+      assign =
+          nullable ? &odbc_result::assign_string<true>
+                   : &odbc_result::assign_string<false>;
+      break;
+    case ustring_t:
+      assign =
+          nullable ? &odbc_result::assign_ustring<true>
+                   : &odbc_result::assign_ustring<false>;
+      break;
+    case logical_t:
+      assign = &odbc_result::assign_logical;
+      break;
+    case raw_t:
+      assign =
+          nullable ? &odbc_result::assign_raw<true>
+                   : &odbc_result::assign_raw<false>;
+      break;
+    default:
+      // Signal once per result set rather than once per cell; the column is
+      // left as allocated by `create_dataframe`.
+      signal_unknown_field_type(types[col], r.column_name(columns[col]));
+      assign = &odbc_result::assign_nothing;
+      break;
+    } // switch (types[col])
+    plan.push_back({assign, columns[col], static_cast<int>(col)});
+  }
+
+  // Drivers without SQL_GD_ANY_ORDER require unbound columns to be read in
+  // increasing order, whatever order they are returned in.
+  std::sort(
+      plan.begin(), plan.end(), [](decode_step const& a, decode_step const& b) {
+        return a.column < b.column;
+      });
+  return plan;
+}
+
+void odbc_result::assign_nothing(
+    SEXP /* out */, size_t /* row */, short /* column */,
+    nanodbc::result& /* value */) {}
+
 template <typename T>
 T odbc_result::safe_get(short column, T fallback, nanodbc::result& value) {
   T res;
@@ -1000,78 +2304,89 @@ T odbc_result::safe_get(short column, T fallback, nanodbc::result& value) {
 }
 
 void odbc_result::assign_integer(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
 
   int res = safe_get<int>(column, NA_INTEGER, value);
-  INTEGER(out[column])[row] = res;
+  INTEGER(out)[row] = res;
 }
 void odbc_result::assign_integer64(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
 
   int64_t res = safe_get<int64_t>(column, NA_INTEGER64, value);
-  INTEGER64(out[column])[row] = res;
+  INTEGER64(out)[row] = res;
 }
 void odbc_result::assign_double(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
 
   double res = safe_get<double>(column, NA_REAL, value);
-  REAL(out[column])[row] = res;
+  REAL(out)[row] = res;
 }
 
 void odbc_result::assign_logical(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
 
   int res = safe_get<int>(column, NA_LOGICAL, value);
-  LOGICAL(out[column])[row] = res;
+  LOGICAL(out)[row] = res;
 }
 
 
 // Strings may be in the server's internal code page, so we need to re-encode
 // in UTF-8 if necessary.
+template <bool Nullable>
 void odbc_result::assign_string(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
   SEXP res;
 
-  if (value.is_null(column)) {
+  if (Nullable && value.is_null(column)) {
     res = NA_STRING;
   } else {
-    auto str = value.get<std::string>(column);
+    auto str = value.get<std::string>(column, std::string());
     if (value.is_null(column)) {
       res = NA_STRING;
     } else {
       res = output_encoder_->makeSEXP(str.c_str(), str.c_str() + str.length());
+      result_bytes_ += r_vector_bytes(LENGTH(res) + 1);
     }
   }
-  SET_STRING_ELT(out[column], row, res);
+  SET_STRING_ELT(out, row, res);
 }
 
-// unicode strings are converted to UTF-8 by nanodbc, so we just need to
-// mark the encoding.
+// unicode strings are fetched as UTF-16 and encoded as UTF-8 directly into
+// a buffer owned by this result, so no per-cell std::string is created.
+template <bool Nullable>
 void odbc_result::assign_ustring(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
   SEXP res;
 
-  if (value.is_null(column)) {
+  if (Nullable && value.is_null(column)) {
     res = NA_STRING;
   } else {
-    auto str = value.get<std::string>(column);
+    value.get_ref<nanodbc::wide_string_type>(
+        column, nanodbc::wide_string_type(), wide_buffer_);
     if (value.is_null(column)) {
       res = NA_STRING;
     } else {
-      res = Rf_mkCharCE(str.c_str(), CE_UTF8);
+      wide_to_utf8(
+          wide_buffer_.data(),
+          wide_buffer_.data() + wide_buffer_.size(),
+          utf8_buffer_);
+      res = Rf_mkCharLenCE(utf8_buffer_.data(), utf8_buffer_.size(), CE_UTF8);
+      result_bytes_ += r_vector_bytes(utf8_buffer_.size() + 1);
     }
   }
-  SET_STRING_ELT(out[column], row, res);
+  SET_STRING_ELT(out, row, res);
 }
 
+template <bool Nullable>
 void odbc_result::assign_datetime(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
   double res;
 
-  if (value.is_null(column)) {
+  if (Nullable && value.is_null(column)) {
     res = NA_REAL;
   } else {
-    auto ts = value.get<nanodbc::timestampoffset>(column);
+    auto ts = value.get<nanodbc::timestampoffset>(
+        column, nanodbc::timestampoffset());
     if (value.is_null(column)) {
       res = NA_REAL;
     } else {
@@ -1079,16 +2394,17 @@ void odbc_result::assign_datetime(
     }
   }
 
-  REAL(out[column])[row] = res;
+  REAL(out)[row] = res;
 }
+template <bool Nullable>
 void odbc_result::assign_date(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
   double res;
 
-  if (value.is_null(column)) {
+  if (Nullable && value.is_null(column)) {
     res = NA_REAL;
   } else {
-    auto ts = value.get<nanodbc::date>(column);
+    auto ts = value.get<nanodbc::date>(column, nanodbc::date());
     if (value.is_null(column)) {
       res = NA_REAL;
     } else {
@@ -1096,16 +2412,17 @@ void odbc_result::assign_date(
     }
   }
 
-  REAL(out[column])[row] = res / seconds_in_day_;
+  REAL(out)[row] = res / seconds_in_day_;
 }
+template <bool Nullable>
 void odbc_result::assign_time(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
   double res;
 
-  if (value.is_null(column)) {
+  if (Nullable && value.is_null(column)) {
     res = NA_REAL;
   } else {
-    auto ts = value.get<nanodbc::time>(column);
+    auto ts = value.get<nanodbc::time>(column, nanodbc::time());
     if (value.is_null(column)) {
       res = NA_REAL;
     } else {
@@ -1113,26 +2430,309 @@ void odbc_result::assign_time(
     }
   }
 
-  REAL(out[column])[row] = res;
+  REAL(out)[row] = res;
 }
 
+template <bool Nullable>
 void odbc_result::assign_raw(
-    Rcpp::List& out, size_t row, short column, nanodbc::result& value) {
+    SEXP out, size_t row, short column, nanodbc::result& value) {
 
   // Same issue as assign_string, null is never true unless the column has
   // been bound
-  if (value.is_null(column)) {
+  if (Nullable && value.is_null(column)) {
     SET_VECTOR_ELT(Rf_allocVector(VECSXP, 1), 0, NILSXP);
     return;
   }
-  std::vector<std::uint8_t> data = value.get<std::vector<std::uint8_t>>(column);
+  std::vector<std::uint8_t> data =
+      value.get<std::vector<std::uint8_t>>(column, std::vector<std::uint8_t>());
   if (value.is_null(column)) {
     SET_VECTOR_ELT(Rf_allocVector(VECSXP, 1), 0, NILSXP);
     return;
   }
   SEXP bytes = Rf_allocVector(RAWSXP, data.size());
   std::copy(data.begin(), data.end(), RAW(bytes));
-  SET_VECTOR_ELT(out[column], row, bytes);
+  SET_VECTOR_ELT(out, row, bytes);
+  result_bytes_ += r_vector_bytes(data.size());
+}
+
+std::unique_ptr<arrow_batches> odbc_result::result_to_arrow(
+    nanodbc::result& r, int n_max, size_t batch_rows) {
+  // Whatever is not spent fetching is spent decoding.
+  auto started = result_stats::clock::now();
+  const double fetch_before = stats_.fetch;
+  const size_t get_data_calls = r.get_data_calls();
+  const size_t get_data_bytes = r.get_data_bytes();
+  const size_t iconv_calls = output_encoder_->conversions();
+  const size_t iconv_bytes = output_encoder_->bytes();
+  const double iconv = output_encoder_->seconds();
+
+  auto all_types = column_types(r);
+  auto all_names = column_names(r);
+  auto columns = output_columns();
+
+  std::vector<arrow_field> fields;
+  std::vector<arrow_column_builder> builders;
+  std::vector<arrow_step> plan;
+  for (size_t col = 0; col < columns.size(); ++col) {
+    short column = columns[col];
+    // Always nullable: drivers report NOT NULL for columns that do return
+    // NULLs, and the schema is fixed before the first batch is fetched.
+    arrow_field field{all_names[column], arrow_utf8, true, ""};
+    arrow_append_fn append;
+    switch (all_types[column]) {
+    case logical_t:
+      field.type = arrow_bool;
+      append = &odbc_result::append_arrow_logical;
+      break;
+    case integer_t:
+      field.type = arrow_int32;
+      append = &odbc_result::append_arrow_integer;
+      break;
+    case integer64_t:
+      field.type = arrow_int64;
+      append = &odbc_result::append_arrow_integer64;
+      break;
+    case odbc::double_t:
+      field.type = arrow_double;
+      append = &odbc_result::append_arrow_double;
+      break;
+    case date_int_t:
+    case date_double_t:
+      field.type = arrow_date32;
+      append = &odbc_result::append_arrow_date;
+      break;
+    case odbc::time_t:
+      field.type = arrow_time64;
+      append = &odbc_result::append_arrow_time;
+      break;
+    case datetime_int_t:
+    case datetime_double_t:
+      field.type = arrow_timestamp;
+      field.timezone = c_->timezone_out_str();
+      append = &odbc_result::append_arrow_datetime;
+      break;
+    case ustring_t:
+      append = &odbc_result::append_arrow_ustring;
+      break;
+    case raw_t:
+      field.type = arrow_binary;
+      append = &odbc_result::append_arrow_raw;
+      break;
+    default:
+      append = &odbc_result::append_arrow_string;
+      break;
+    }
+    fields.push_back(field);
+    builders.emplace_back(field.type);
+    plan.push_back({append, column, static_cast<int>(col)});
+  }
+  // Unbound columns must be retrieved in increasing order; see
+  // `decode_plan`.
+  std::sort(
+      plan.begin(), plan.end(), [](arrow_step const& a, arrow_step const& b) {
+        return a.column < b.column;
+      });
+
+  // Offsets are 32 bit, so strings and blobs are limited to 2GB per batch.
+  const size_t max_batch_bytes = 1u << 30;
+  auto batch_full = [&builders, max_batch_bytes]() {
+    for (auto const& builder : builders) {
+      if (builder.data_bytes() > max_batch_bytes) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::unique_ptr<arrow_batches> out(new arrow_batches(fields));
+  utils::cancel_timer timer(deadline_after(timeout_), [this]() {
+    timed_out_ = true;
+    s_->cancel();
+  });
+
+  if (!positioned_ && n_max != 0) {
+    auto fetched = result_stats::clock::now();
+    complete_ = !r.next() && !nextResultSet(r);
+    stats_.fetch += result_stats::since(fetched);
+    ++stats_.fetch_calls;
+    positioned_ = true;
+  }
+
+  size_t rows = 0;
+  size_t batch = 0;
+  while (!complete_) {
+    if (n_max >= 0 && rows >= static_cast<size_t>(n_max)) {
+      break;
+    }
+    for (auto const& step : plan) {
+      (this->*step.append)(builders[step.target], step.column, r);
+    }
+
+    auto fetched = result_stats::clock::now();
+    complete_ = !r.next();
+    stats_.fetch += result_stats::since(fetched);
+    ++stats_.fetch_calls;
+    ++rows;
+    ++batch;
+    ++rows_fetched_;
+    if (rows_fetched_ % 16384 == 0) {
+      Rcpp::checkUserInterrupt();
+    }
+    if (timed_out_) {
+      raise_timeout();
+    }
+    complete_ = complete_ && !nextResultSet(r);
+
+    if (batch == batch_rows || batch_full()) {
+      out->push_back(builders, batch);
+      batch = 0;
+    }
+  }
+  // An empty result is a single empty batch.
+  if (batch > 0 || out->size() == 0) {
+    out->push_back(builders, batch);
+  }
+
+  stats_.rows += rows;
+  stats_.get_data_calls += r.get_data_calls() - get_data_calls;
+  stats_.get_data_bytes += r.get_data_bytes() - get_data_bytes;
+  stats_.iconv_calls += output_encoder_->conversions() - iconv_calls;
+  stats_.iconv_bytes += output_encoder_->bytes() - iconv_bytes;
+  stats_.iconv += output_encoder_->seconds() - iconv;
+  stats_.decode +=
+      result_stats::since(started) - (stats_.fetch - fetch_before);
+  return out;
+}
+
+void odbc_result::append_arrow_logical(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  int res = value.get<int>(column, 0);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    out.append_bool(res != 0);
+  }
+}
+
+void odbc_result::append_arrow_integer(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  int res = value.get<int>(column, 0);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    out.append_int32(res);
+  }
+}
+
+void odbc_result::append_arrow_integer64(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  int64_t res = value.get<int64_t>(column, 0);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    out.append_int64(res);
+  }
+}
+
+void odbc_result::append_arrow_double(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  double res = value.get<double>(column, 0);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    out.append_double(res);
+  }
+}
+
+void odbc_result::append_arrow_date(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  if (value.is_null(column)) {
+    out.append_null();
+    return;
+  }
+  auto dt = value.get<nanodbc::date>(column);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    out.append_int32(static_cast<int32_t>(as_double(dt) / seconds_in_day_));
+  }
+}
+
+void odbc_result::append_arrow_time(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  if (value.is_null(column)) {
+    out.append_null();
+    return;
+  }
+  auto ts = value.get<nanodbc::time>(column);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    int64_t seconds = ts.hour * 3600 + ts.min * 60 + ts.sec;
+    out.append_int64(seconds * 1000000);
+  }
+}
+
+void odbc_result::append_arrow_datetime(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  if (value.is_null(column)) {
+    out.append_null();
+    return;
+  }
+  auto ts = value.get<nanodbc::timestampoffset>(column);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    out.append_int64(std::llround(as_double(ts) * 1e6));
+  }
+}
+
+void odbc_result::append_arrow_string(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  if (value.is_null(column)) {
+    out.append_null();
+    return;
+  }
+  value.get_ref<std::string>(column, string_buffer_);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    utf8_buffer_ = output_encoder_->makeString(
+        string_buffer_.data(), string_buffer_.data() + string_buffer_.size());
+    out.append_bytes(utf8_buffer_.data(), utf8_buffer_.size());
+  }
+}
+
+void odbc_result::append_arrow_ustring(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  if (value.is_null(column)) {
+    out.append_null();
+    return;
+  }
+  value.get_ref<nanodbc::wide_string_type>(column, wide_buffer_);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    wide_to_utf8(
+        wide_buffer_.data(), wide_buffer_.data() + wide_buffer_.size(),
+        utf8_buffer_);
+    out.append_bytes(utf8_buffer_.data(), utf8_buffer_.size());
+  }
+}
+
+void odbc_result::append_arrow_raw(
+    arrow_column_builder& out, short column, nanodbc::result& value) {
+  if (value.is_null(column)) {
+    out.append_null();
+    return;
+  }
+  value.get_ref<std::vector<std::uint8_t>>(column, raw_buffer_);
+  if (value.is_null(column)) {
+    out.append_null();
+  } else {
+    out.append_bytes(
+        reinterpret_cast<const char*>(raw_buffer_.data()), raw_buffer_.size());
+  }
 }
 
 // Infer number of rows across parameters.
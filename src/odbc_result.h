@@ -3,10 +3,17 @@
 #include <Rcpp.h>
 
 #include "Iconv.h"
+#include "arrow_export.h"
+#include "arrow_import.h"
 #include "condition.h"
+#include "csv_reader.h"
+#include "csv_writer.h"
 #include "nanodbc.h"
 #include "odbc_connection.h"
 #include "r_types.h"
+#include "result_stats.h"
+#include <atomic>
+#include <future>
 
 namespace odbc {
 
@@ -45,6 +52,8 @@ public:
   struct param_data {
     std::map<short, std::vector<std::string>> strings_;
     std::map<short, std::vector<std::vector<uint8_t>>> raws_;
+    std::map<short, std::vector<int>> integers_;
+    std::map<short, std::vector<double>> doubles_;
     std::map<short, std::vector<nanodbc::time>> times_;
     std::map<short, std::vector<nanodbc::timestamp>> timestamps_;
     std::map<short, std::vector<nanodbc::timestampoffset>> timestampoffsets_;
@@ -57,23 +66,131 @@ public:
     void push_back(short i, const nanodbc::timestampoffset& tso) {
       timestampoffsets_[i].push_back(tso);
     };
+
+    // Bytes of parameter values bound, for progress reports.
+    size_t bytes() const;
   };
+  /// \param async If `true`, the statement is prepared and executed on a
+  /// separate thread and the constructor returns straight away.  Use
+  /// `ready()` to poll for, and `wait()` to wait for, completion.
+  /// \param cursor_type,concurrency Values for the `SQL_ATTR_CURSOR_TYPE`
+  /// and `SQL_ATTR_CONCURRENCY` statement attributes.  Statements with
+  /// other than the default forward-only, read-only cursor are not shared
+  /// through the connection's statement cache.
+  /// \param timeout Seconds each execution and each fetch may take, or 0
+  /// for no limit.  Passed to the driver as `SQL_ATTR_QUERY_TIMEOUT`, and
+  /// enforced by cancelling the statement, so that drivers that ignore
+  /// the attribute are stopped too: from the main thread while executing,
+  /// and from a timer thread while fetching, which also stops a fetch
+  /// blocked in the driver.
   odbc_result(
-      std::shared_ptr<odbc_connection> c, std::string sql, bool immediate);
+      std::shared_ptr<odbc_connection> c,
+      std::string sql,
+      bool immediate,
+      bool async = false,
+      long cursor_type = SQL_CURSOR_FORWARD_ONLY,
+      long concurrency = SQL_CONCUR_READ_ONLY,
+      double timeout = 0);
   std::shared_ptr<odbc_connection> connection() const;
   std::shared_ptr<nanodbc::statement> statement() const;
   std::shared_ptr<nanodbc::result> result() const;
   void prepare();
   void describe_parameters(Rcpp::List const& x);
   void bind_list(Rcpp::List const& x, bool use_transaction, size_t batch_rows);
+
+  /// \brief Bind the record batches of an Arrow stream as parameter arrays,
+  /// executing the statement once per `batch_rows` rows.
+  ///
+  /// Fixed-width columns with the layout of an ODBC C type are bound
+  /// straight from the Arrow buffers, without copying; validity bitmaps are
+  /// expanded into null indicators.
+  /// \param stream A stream of struct arrays with one child per parameter.
+  /// It is read to the end but not released.
+  /// \param encoding Encoding to convert strings to from UTF-8, or empty to
+  /// bind them unchanged.
+  /// \return The number of rows bound.
+  double bind_arrow(
+      ArrowArrayStream* stream,
+      bool use_transaction,
+      size_t batch_rows,
+      std::string const& encoding);
+
+  /// \brief Bind the rows of a delimited file as parameter arrays, in a
+  /// transaction, executing the statement once per `batch_rows` rows.
+  ///
+  /// Fields are converted according to the described parameter types:
+  /// integers and floating point numbers are parsed, and ISO 8601 dates,
+  /// times and timestamps are converted, timestamps with a `Z` or UTC
+  /// offset to civil time in the connection's time zone.  Other fields are
+  /// bound as text for the driver to convert.  The next rows are parsed
+  /// on a pool thread while the statement executes.
+  /// \param options `na` is the unquoted field value bound as null;
+  /// `header` skips the first row.
+  /// \param encoding Encoding to convert text to from UTF-8, or empty to
+  /// bind it unchanged.
+  /// \return The number of rows bound.
+  double import_csv(
+      std::string const& path,
+      csv_options const& options,
+      size_t batch_rows,
+      std::string const& encoding);
   Rcpp::DataFrame fetch(int n_max = -1);
 
+  /// \brief Fetch rows into Arrow record batches, without creating any [R]
+  /// objects.
+  ///
+  /// Columns have the Arrow equivalent of the type `fetch` would return.
+  /// All rows are fetched before returning, so that `out` can be read after
+  /// this result is gone.
+  /// \param out An unused stream, which takes ownership of the batches.
+  /// \param batch_rows Maximum number of rows per record batch.
+  void fetch_arrow(ArrowArrayStream* out, int n_max, size_t batch_rows);
+
+  /// \brief Write the remaining rows to a CSV file, without creating any
+  /// [R] objects.
+  ///
+  /// Rows are fetched `batch_rows` at a time into Arrow record batches,
+  /// which a `csv_writer` formats and writes on a pool thread, so memory
+  /// use does not depend on the number of rows.
+  /// \return The number of rows written.
+  double export_csv(
+      std::string const& path, csv_options const& options, size_t batch_rows);
+
+  /// \brief Position the cursor so that the next fetch starts after the
+  /// first `offset` rows of the result, using `SQLFetchScroll`.
+  ///
+  /// Requires a scrollable (not forward-only) cursor.
+  void seek(long offset);
+
+  /// \brief Restrict fetches to the named columns, in the given order.
+  ///
+  /// Columns that are not selected are unbound and never retrieved from
+  /// the driver.  As they cannot be bound again, the selection can only be
+  /// set once per result, before any rows are fetched.
+  /// \param names Column names, UTF-8 encoded.
+  void select_columns(std::vector<std::string> const& names);
+
   int rows_fetched();
 
   bool complete();
 
   bool active();
 
+  /// \brief Whether execution has finished.  Always true unless the result
+  /// was created with `async`.
+  bool ready() const;
+
+  /// \brief Wait for asynchronous execution to finish, checking for user
+  /// interrupts.
+  ///
+  /// \param raise If `true`, errors from the execution thread are raised
+  /// here as [R] errors.  Otherwise they are kept for a later `wait()`.
+  /// Execution running past the `timeout` is cancelled either way.
+  void wait(bool raise = true);
+
+  /// \brief Timers and counters for the phases of running this result.
+  result_stats const& get_stats() const;
+
   ~odbc_result();
 
 private:
@@ -89,20 +206,79 @@ private:
   bool complete_;
   bool bound_;
   bool immediate_;
+  long cursor_type_;
+  long concurrency_;
+  // Whether the cursor is on the next row to fetch; false until the first
+  // row of a new result set is read.
+  bool positioned_;
+  // Set by `execute()` when it prepared `s_`, for `cache_statement()`.
+  bool prepared_;
+  // Set while `execute()` runs away from the main thread; errors are then
+  // thrown as `odbc_error` rather than raised.
+  bool threaded_;
+  // Outcome of asynchronous execution, until collected by `wait()`.
+  std::future<void> pending_;
+  double timeout_;
+  // When the pending execution is cancelled, if `timeout_` is set.
+  std::chrono::steady_clock::time_point deadline_;
+  // Set when execution or fetching is cancelled for running past
+  // `timeout_`; fetches are cancelled from a timer thread.
+  std::atomic<bool> timed_out_;
+  // Bytes allocated for the data frame being filled by
+  // `result_to_dataframe`, including the strings and raw vectors in it.
+  double result_bytes_;
+  result_stats stats_;
+  result_stats reported_stats_;
   std::shared_ptr<Iconv> output_encoder_;
   std::shared_ptr<Iconv> column_name_encoder_;
 
   param_data buffers_;
   std::map<short, param_data> tvp_buffers_;
 
+  // Result set positions of the selected columns, in output order.  Empty
+  // when every column is fetched.
+  std::vector<short> selected_columns_;
+
+  // Scratch space re-used by assign_ustring and the append_arrow_* methods
+  // for every string and binary cell.
+  nanodbc::wide_string_type wide_buffer_;
+  std::string utf8_buffer_;
+  std::string string_buffer_;
+  std::vector<std::uint8_t> raw_buffer_;
+
   void clear_buffers();
   void unbind_if_needed();
+  bool is_selected(short column) const;
+  // Result set positions of the output columns.
+  std::vector<short> output_columns() const;
 
   // Private method - use only in constructor.
   // It will allocate nanodbc resources ( statement, result )
   // and call execute.
   void execute();
 
+  // A statement for `sql_`: a cached prepared statement, if available,
+  // otherwise a new, unopened one.
+  std::shared_ptr<nanodbc::statement> new_statement();
+
+  // Offer the statement `execute()` prepared to the connection's statement
+  // cache.  The cache is not thread safe, so this runs on the main thread
+  // once execution has finished.
+  void cache_statement();
+
+  void cancel_execution();
+  void cleanup_execution();
+
+  // `timeout_` in whole seconds, for `SQL_ATTR_QUERY_TIMEOUT`.
+  long query_timeout() const;
+  void raise_timeout() const;
+  void raise_if_timed_out() const;
+  void raise_memory_limit(double limit, int rows) const;
+
+  // Add what `stats_` gained since the last call to the connection's
+  // totals.  Called on the main thread only.
+  void report_stats();
+
   template<typename T>
   void bind_columns(
       T& obj,
@@ -160,6 +336,15 @@ private:
       size_t size,
       param_data& buffers);
 
+  // Scale factors for `as_timestamp`, from the precision of the datetime
+  // parameter `column`.
+  template <typename T>
+  void datetime_precision(
+      T& obj,
+      short column,
+      unsigned long long& factor,
+      unsigned long long& pad);
+
   template<typename T, typename SourceType>
   void bind_datetime(
       T& obj,
@@ -200,6 +385,85 @@ private:
       size_t size,
       param_data& buffers);
 
+  // Bind `size` values of an Arrow column, starting at `start`.  `start`
+  // includes the offset of the parent record batch but not the column's
+  // own offset.
+  void bind_arrow_column(
+      ArrowSchema const& schema,
+      ArrowArray const& array,
+      short column,
+      size_t start,
+      size_t size,
+      Iconv* encoder);
+
+  // Null flags for `bind`, from the validity bitmap of `array`; nullptr
+  // when the column has no nulls.
+  bool* arrow_nulls(
+      ArrowArray const& array, short column, size_t start, size_t size);
+
+  // Bound in place; `T` must have the layout of the Arrow type.
+  template <typename T>
+  void bind_arrow_fixed(
+      ArrowArray const& array, short column, size_t start, size_t size);
+  // Widened to `int`.
+  template <typename T>
+  void bind_arrow_integer(
+      ArrowArray const& array, short column, size_t start, size_t size);
+  void bind_arrow_logical(
+      ArrowArray const& array, short column, size_t start, size_t size);
+  template <typename Offset>
+  void bind_arrow_string(
+      ArrowArray const& array,
+      short column,
+      size_t start,
+      size_t size,
+      Iconv* encoder);
+  template <typename Offset>
+  void bind_arrow_raw(
+      ArrowArray const& array, short column, size_t start, size_t size);
+  // Dictionary encoded strings, such as converted factors.
+  void bind_arrow_dictionary(
+      ArrowSchema const& schema,
+      ArrowArray const& array,
+      short column,
+      size_t start,
+      size_t size,
+      Iconv* encoder);
+  // `unit` is the length of one unit of the Arrow value in seconds.
+  template <typename T>
+  void bind_arrow_date(
+      ArrowArray const& array,
+      short column,
+      size_t start,
+      size_t size,
+      double unit);
+  template <typename T>
+  void bind_arrow_time(
+      ArrowArray const& array,
+      short column,
+      size_t start,
+      size_t size,
+      double unit);
+  // Timestamps with a time zone are instants, bound as civil time in the
+  // connection's time zone, like `POSIXct` values.  Timestamps without one
+  // are bound as they are.
+  void bind_arrow_datetime(
+      ArrowArray const& array,
+      short column,
+      size_t start,
+      size_t size,
+      double unit,
+      bool instant);
+
+  // Bind field `column` of the rows in `chunk`, as a parameter of SQL type
+  // `sql_type`.
+  void bind_csv_column(
+      csv_chunk const& chunk,
+      short column,
+      short sql_type,
+      std::string const& na,
+      Iconv* encoder);
+
   // Convert the `double` value [R] timestamp into
   // a `nanodbc::timestamp` struct.  Will use
   // `cctz` library to make the conversion to
@@ -248,6 +512,64 @@ private:
 
   Rcpp::List result_to_dataframe(nanodbc::result& r, int n_max = -1);
 
+  typedef void (odbc_result::*assign_fn)(
+      SEXP out, size_t row, short column, nanodbc::result& value);
+
+  struct decode_step {
+    assign_fn assign;
+    short column; // Position in the result set
+    int target;   // Position in the output data frame
+  };
+
+  /// \brief Resolve the `assign_*` method for every column up front.
+  ///
+  /// The column types of a result set are fixed once it has been executed,
+  /// so `result_to_dataframe` dispatches on them once per fetch rather than
+  /// once per cell.  Steps are ordered by result set position, the order in
+  /// which unbound columns must be retrieved.
+  /// \param columns Result set positions of the output columns.
+  /// \param types Output column types.
+  /// \param r nanodbc::result, used for nullability and column names.
+  std::vector<decode_step> decode_plan(
+      std::vector<short> const& columns,
+      std::vector<r_type> const& types,
+      nanodbc::result const& r);
+
+  std::unique_ptr<arrow_batches> result_to_arrow(
+      nanodbc::result& r, int n_max, size_t batch_rows);
+
+  typedef void (odbc_result::*arrow_append_fn)(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+
+  struct arrow_step {
+    arrow_append_fn append;
+    short column; // Position in the result set
+    int target;   // Position in the record batch
+  };
+
+  // The Arrow counterparts of the `assign_*` methods below, resolved once
+  // per fetch in the same way.
+  void append_arrow_logical(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_integer(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_integer64(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_double(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_date(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_time(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_datetime(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_string(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_ustring(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+  void append_arrow_raw(
+      arrow_column_builder& out, short column, nanodbc::result& value);
+
   /// \brief Safely gets data from the given column of the current rowset.
   ///
   /// There is a bug/limitation in ODBC drivers for SQL Server (and
@@ -270,35 +592,53 @@ private:
   template <typename T>
   T safe_get(short column, T fallback, nanodbc::result& value);
 
+  // Numeric values are read with `safe_get`, which checks the null
+  // indicator after `get`, whatever the column's reported nullability.
   void assign_integer(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
   void assign_integer64(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
   void assign_double(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
+
+  // The other assign_ methods are instantiated twice: `Nullable = false` is
+  // used for columns the driver reports as NOT NULL and skips the null
+  // indicator check before `get`.  The check after it is always made: the
+  // indicator of a column read with SQLGetData is only set by that read,
+  // and drivers report NOT NULL for e.g. the nullable side of an outer join.
 
   // Strings may be in the server's internal code page, so we need to re-encode
   // in UTF-8 if necessary.
+  template <bool Nullable>
   void assign_string(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
 
-  // unicode strings are converted to UTF-8 by nanodbc, so we just need to
-  // mark the encoding.
+  // unicode strings are fetched as UTF-16 and encoded as UTF-8 by
+  // wide_to_utf8 (see unicode.h).
+  template <bool Nullable>
   void assign_ustring(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
 
+  template <bool Nullable>
   void assign_datetime(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
+  template <bool Nullable>
   void assign_date(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
+  template <bool Nullable>
   void assign_time(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
 
   void assign_logical(
-      Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+      SEXP out, size_t row, short column, nanodbc::result& value);
 
+  template <bool Nullable>
   void
-  assign_raw(Rcpp::List& out, size_t row, short column, nanodbc::result& value);
+  assign_raw(SEXP out, size_t row, short column, nanodbc::result& value);
+
+  // Placeholder for columns of unknown type; leaves the cell untouched.
+  void assign_nothing(
+      SEXP out, size_t row, short column, nanodbc::result& value);
 
   /// \brief Helper method to infer the parameter length from a list
   /// of one or more parameters.
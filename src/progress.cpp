@@ -0,0 +1,76 @@
+#include "progress.h"
+
+#include <cli/progress.h>
+#include <cstdio>
+
+namespace odbc {
+
+namespace {
+
+void done_bar(void* bar) { cli_progress_done(static_cast<SEXP>(bar)); }
+
+} // namespace
+
+progress::progress(const char* name, double total)
+    : bar_(R_NilValue),
+      rows_(0),
+      bytes_(0),
+      started_(std::chrono::steady_clock::now()) {
+  if (!wanted()) {
+    return;
+  }
+  bool known = total >= 0;
+  Rcpp::List config = Rcpp::List::create(
+      Rcpp::_["name"] = name,
+      Rcpp::_["status"] = "",
+      Rcpp::_["format"] =
+          known ? "{cli::pb_name}{cli::pb_bar} {cli::pb_current}/"
+                  "{cli::pb_total} rows | {cli::pb_rate} | {cli::pb_status}"
+                  " | ETA: {cli::pb_eta}"
+                : "{cli::pb_name}{cli::pb_current} rows | {cli::pb_rate} | "
+                  "{cli::pb_status} | {cli::pb_elapsed}");
+  bar_ = cli_progress_bar(known ? total : NA_REAL, config);
+  R_PreserveObject(bar_);
+}
+
+bool progress::wanted() {
+  return Rf_asLogical(Rf_GetOption1(Rf_install("odbc.progress"))) == TRUE;
+}
+
+progress::~progress() {
+  if (enabled()) {
+    // Unwinding from an error: R errors must not escape the destructor.
+    R_ToplevelExec(done_bar, bar_);
+    R_ReleaseObject(bar_);
+  }
+}
+
+void progress::done() {
+  if (enabled()) {
+    cli_progress_done(bar_);
+    R_ReleaseObject(bar_);
+    bar_ = R_NilValue;
+  }
+}
+
+void progress::tick() {
+  if (!CLI_SHOULD_TICK) {
+    return;
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - started_)
+                       .count();
+  double rate = seconds > 0 ? bytes_ / seconds : 0;
+  const char* units[] = {"B", "kB", "MB", "GB", "TB"};
+  size_t unit = 0;
+  while (rate >= 1000 && unit < 4) {
+    rate /= 1000;
+    ++unit;
+  }
+  char status[32];
+  std::snprintf(status, sizeof(status), "%.1f %s/s", rate, units[unit]);
+  cli_progress_set_status(bar_, status);
+  cli_progress_set(bar_, rows_);
+}
+
+} // namespace odbc
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Rcpp.h>
+#include <chrono>
+
+namespace odbc {
+
+/// \brief A cli progress bar for a long fetch or insert.
+///
+/// Only created when the `odbc.progress` option is `TRUE`, and only shown
+/// by cli once the operation has run for a couple of seconds, so that
+/// short operations never show one.  The bar shows rows and rows per
+/// second, bytes per second, and an estimate of the time left when the
+/// total number of rows is known.
+///
+/// `update()` is cheap enough to call for every row: the bar is redrawn
+/// only when cli's timer says it is due.  Call from the main [R] thread
+/// only.
+class progress {
+public:
+  /// \param total Number of rows expected, or a negative number if unknown.
+  progress(const char* name, double total);
+
+  /// \brief Removes the bar, if `done()` was not called.
+  ~progress();
+
+  progress(progress const&) = delete;
+  progress& operator=(progress const&) = delete;
+
+  /// \brief Whether progress bars were asked for, with `odbc.progress`.
+  static bool wanted();
+
+  bool enabled() const { return bar_ != R_NilValue; }
+
+  /// \brief Report `rows` rows and `bytes` bytes done so far.
+  void update(double rows, double bytes) {
+    if (enabled()) {
+      rows_ = rows;
+      bytes_ = bytes;
+      tick();
+    }
+  }
+
+  void done();
+
+private:
+  SEXP bar_;
+  double rows_;
+  double bytes_;
+  std::chrono::steady_clock::time_point started_;
+
+  void tick();
+};
+
+} // namespace odbc
@@ -14,21 +14,72 @@ bool result_active(result_ptr const& r) {
 }
 
 // [[Rcpp::export]]
-bool result_completed(result_ptr const& r) { return r->complete(); }
+bool result_completed(result_ptr const& r) {
+  r->wait();
+  return r->complete();
+}
 
 // [[Rcpp::export]]
 result_ptr new_result(
-    connection_ptr const& p, std::string const& sql, const bool immediate) {
-  return result_ptr(new odbc::odbc_result(*p, sql, immediate));
+    connection_ptr const& p,
+    std::string const& sql,
+    const bool immediate,
+    const bool async,
+    long cursor_type,
+    long concurrency,
+    double timeout) {
+  return result_ptr(new odbc::odbc_result(
+      *p, sql, immediate, async, cursor_type, concurrency, timeout));
 }
 
+// [[Rcpp::export]]
+bool result_ready(result_ptr const& r) { return r->ready(); }
+
+// [[Rcpp::export]]
+void result_wait(result_ptr const& r) { r->wait(); }
+
 // [[Rcpp::export]]
 List result_fetch(result_ptr const& r, const int n_max = -1) {
+  r->wait();
   return r->fetch(n_max);
 }
 
+// [[Rcpp::export]]
+void result_fetch_arrow(
+    result_ptr const& r, SEXP stream, const int n_max, size_t batch_rows) {
+  if (TYPEOF(stream) != EXTPTRSXP || R_ExternalPtrAddr(stream) == nullptr) {
+    Rcpp::stop("`stream` must be an allocated `nanoarrow_array_stream`.");
+  }
+  auto out = static_cast<ArrowArrayStream*>(R_ExternalPtrAddr(stream));
+  if (out->release != nullptr) {
+    Rcpp::stop("`stream` must not be in use.");
+  }
+  r->wait();
+  r->fetch_arrow(out, n_max, batch_rows);
+}
+
+// [[Rcpp::export]]
+void result_seek(result_ptr const& r, double offset) {
+  r->wait();
+  r->seek(static_cast<long>(offset));
+}
+
+// [[Rcpp::export]]
+Rcpp::List result_timings(result_ptr const& r) {
+  r->wait();
+  return r->get_stats().to_list();
+}
+
+// [[Rcpp::export]]
+void result_select_columns(
+    result_ptr const& r, std::vector<std::string> const& columns) {
+  r->wait();
+  r->select_columns(columns);
+}
+
 // [[Rcpp::export]]
 Rcpp::DataFrame result_column_info(result_ptr const& r) {
+  r->wait();
   auto result = r->result();
 
   std::vector<std::string> names;
@@ -46,22 +97,68 @@ Rcpp::DataFrame result_column_info(result_ptr const& r) {
 
 // [[Rcpp::export]]
 void result_bind(result_ptr const& r, List const& params, size_t batch_rows) {
+  r->wait();
   r->bind_list(params, false, batch_rows);
 }
 
+// [[Rcpp::export]]
+double result_export_csv(
+    result_ptr const& r,
+    std::string const& path,
+    std::string const& delim,
+    std::string const& na,
+    bool header,
+    size_t batch_rows) {
+  r->wait();
+  return r->export_csv(path, {delim[0], na, header}, batch_rows);
+}
+
 // [[Rcpp::export]]
 void result_insert_dataframe(
     result_ptr const& r, DataFrame const& df, size_t batch_rows) {
+  r->wait();
   r->bind_list(df, true, batch_rows);
 }
 
+// [[Rcpp::export]]
+double result_insert_arrow(
+    result_ptr const& r,
+    SEXP stream,
+    size_t batch_rows,
+    std::string const& encoding) {
+  if (TYPEOF(stream) != EXTPTRSXP || R_ExternalPtrAddr(stream) == nullptr) {
+    Rcpp::stop("`stream` must be a `nanoarrow_array_stream`.");
+  }
+  auto in = static_cast<ArrowArrayStream*>(R_ExternalPtrAddr(stream));
+  if (in->release == nullptr) {
+    Rcpp::stop("`stream` has already been released.");
+  }
+  r->wait();
+  return r->bind_arrow(in, true, batch_rows, encoding);
+}
+
+// [[Rcpp::export]]
+double result_import_csv(
+    result_ptr const& r,
+    std::string const& path,
+    std::string const& delim,
+    std::string const& na,
+    bool header,
+    size_t batch_rows,
+    std::string const& encoding) {
+  r->wait();
+  return r->import_csv(path, {delim[0], na, header}, batch_rows, encoding);
+}
+
 // [[Rcpp::export]]
 void result_describe_parameters(result_ptr const& r, DataFrame const& df) {
+  r->wait();
   r->describe_parameters(df);
 }
 
 // [[Rcpp::export]]
 int result_rows_affected(result_ptr const& r) {
+  r->wait();
   auto res = r->result();
   if (!res) {
     return 0;
@@ -70,7 +167,30 @@ int result_rows_affected(result_ptr const& r) {
 }
 
 // [[Rcpp::export]]
-int result_row_count(result_ptr const& r) { return r->rows_fetched(); }
+int result_row_count(result_ptr const& r) {
+  r->wait();
+  return r->rows_fetched();
+}
+
+// [[Rcpp::export]]
+Rcpp::IntegerVector cursor_types() {
+  Rcpp::IntegerVector out = Rcpp::IntegerVector::create(
+      Rcpp::_["forward_only"] = SQL_CURSOR_FORWARD_ONLY,
+      Rcpp::_["static"] = SQL_CURSOR_STATIC,
+      Rcpp::_["keyset"] = SQL_CURSOR_KEYSET_DRIVEN,
+      Rcpp::_["dynamic"] = SQL_CURSOR_DYNAMIC);
+  return out;
+}
+
+// [[Rcpp::export]]
+Rcpp::IntegerVector cursor_concurrencies() {
+  Rcpp::IntegerVector out = Rcpp::IntegerVector::create(
+      Rcpp::_["read_only"] = SQL_CONCUR_READ_ONLY,
+      Rcpp::_["lock"] = SQL_CONCUR_LOCK,
+      Rcpp::_["rowver"] = SQL_CONCUR_ROWVER,
+      Rcpp::_["values"] = SQL_CONCUR_VALUES);
+  return out;
+}
 
 // [[Rcpp::export]]
 void column_types(DataFrame const& df) {
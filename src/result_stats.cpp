@@ -0,0 +1,105 @@
+#include "result_stats.h"
+
+namespace odbc {
+
+namespace {
+
+const char* const type_names[] = {
+    "logical",
+    "integer",
+    "integer64",
+    "double",
+    "date",
+    "date",
+    "datetime",
+    "datetime",
+    "time",
+    "string",
+    "ustring",
+    "raw",
+    "dataframe",
+};
+
+} // namespace
+
+result_stats& result_stats::operator+=(result_stats const& x) {
+  prepare += x.prepare;
+  executions += x.executions;
+  execute += x.execute;
+  fetch_calls += x.fetch_calls;
+  fetch += x.fetch;
+  rows += x.rows;
+  decode += x.decode;
+  for (size_t i = 0; i < decode_by_type.size(); ++i) {
+    decode_by_type[i] += x.decode_by_type[i];
+  }
+  get_data_calls += x.get_data_calls;
+  get_data_bytes += x.get_data_bytes;
+  iconv_calls += x.iconv_calls;
+  iconv_bytes += x.iconv_bytes;
+  iconv += x.iconv;
+  allocations += x.allocations;
+  resizes += x.resizes;
+  allocate += x.allocate;
+  return *this;
+}
+
+result_stats result_stats::operator-(result_stats const& x) const {
+  result_stats out = *this;
+  out.prepare -= x.prepare;
+  out.executions -= x.executions;
+  out.execute -= x.execute;
+  out.fetch_calls -= x.fetch_calls;
+  out.fetch -= x.fetch;
+  out.rows -= x.rows;
+  out.decode -= x.decode;
+  for (size_t i = 0; i < decode_by_type.size(); ++i) {
+    out.decode_by_type[i] -= x.decode_by_type[i];
+  }
+  out.get_data_calls -= x.get_data_calls;
+  out.get_data_bytes -= x.get_data_bytes;
+  out.iconv_calls -= x.iconv_calls;
+  out.iconv_bytes -= x.iconv_bytes;
+  out.iconv -= x.iconv;
+  out.allocations -= x.allocations;
+  out.resizes -= x.resizes;
+  out.allocate -= x.allocate;
+  return out;
+}
+
+Rcpp::List result_stats::to_list() const {
+  // Types decoded by several `assign_*` methods are reported together.
+  Rcpp::NumericVector by_type;
+  for (size_t i = 0; i < decode_by_type.size(); ++i) {
+    if (decode_by_type[i] <= 0) {
+      continue;
+    }
+    std::string name = type_names[i];
+    if (by_type.containsElementNamed(name.c_str())) {
+      by_type[name] = static_cast<double>(by_type[name]) + decode_by_type[i];
+    } else {
+      by_type.push_back(decode_by_type[i], name);
+    }
+  }
+
+  // Counters are doubles, as they may overflow R integers.
+  return Rcpp::List::create(
+      Rcpp::_["prepare"] = prepare,
+      Rcpp::_["executions"] = static_cast<double>(executions),
+      Rcpp::_["execute"] = execute,
+      Rcpp::_["fetch_calls"] = static_cast<double>(fetch_calls),
+      Rcpp::_["fetch"] = fetch,
+      Rcpp::_["rows"] = static_cast<double>(rows),
+      Rcpp::_["decode"] = decode,
+      Rcpp::_["decode_by_type"] = by_type,
+      Rcpp::_["get_data_calls"] = static_cast<double>(get_data_calls),
+      Rcpp::_["get_data_bytes"] = static_cast<double>(get_data_bytes),
+      Rcpp::_["iconv_calls"] = static_cast<double>(iconv_calls),
+      Rcpp::_["iconv_bytes"] = static_cast<double>(iconv_bytes),
+      Rcpp::_["iconv"] = iconv,
+      Rcpp::_["allocations"] = static_cast<double>(allocations),
+      Rcpp::_["resizes"] = static_cast<double>(resizes),
+      Rcpp::_["allocate"] = allocate);
+}
+
+} // namespace odbc
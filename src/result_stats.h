@@ -0,0 +1,53 @@
+#pragma once
+
+#include "r_types.h"
+#include <Rcpp.h>
+#include <array>
+#include <chrono>
+
+namespace odbc {
+
+/// \brief Timers and counters for the phases of running a query.
+///
+/// Kept per `odbc_result`, and summed per `odbc_connection`.  Times are
+/// in seconds.
+struct result_stats {
+  typedef std::chrono::steady_clock clock;
+
+  // SQLPrepare.
+  double prepare = 0;
+  // SQLExecute and SQLExecDirect, including parameter batches.
+  size_t executions = 0;
+  double execute = 0;
+  // SQLFetch, SQLFetchScroll and SQLMoreResults.
+  size_t fetch_calls = 0;
+  double fetch = 0;
+  // Converting values into R vectors, including SQLGetData and iconv.
+  size_t rows = 0;
+  double decode = 0;
+  // Decode time per R type, sampled on one row in `decode_sample_rows`
+  // and scaled up.
+  std::array<double, dataframe_t + 1> decode_by_type{};
+  size_t get_data_calls = 0;
+  size_t get_data_bytes = 0;
+  size_t iconv_calls = 0;
+  size_t iconv_bytes = 0;
+  double iconv = 0;
+  // Allocating and resizing result data frames.
+  size_t allocations = 0;
+  size_t resizes = 0;
+  double allocate = 0;
+
+  static const int decode_sample_rows = 16;
+
+  static double since(clock::time_point start) {
+    return std::chrono::duration<double>(clock::now() - start).count();
+  }
+
+  result_stats& operator+=(result_stats const& x);
+  result_stats operator-(result_stats const& x) const;
+
+  Rcpp::List to_list() const;
+};
+
+} // namespace odbc
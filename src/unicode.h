@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace odbc {
+
+/// \brief Encode UTF-16 (or, with iODBC wide strings, UTF-32) code units
+/// as UTF-8.
+///
+/// Writes into `out`, which is resized to fit and whose capacity is re-used
+/// across calls; callers are expected to keep one buffer per result set.
+/// Conversion stops at the first NUL code unit, matching the C-string
+/// semantics R applies to CHARSXPs.  Unpaired surrogates are replaced with
+/// U+FFFD.
+///
+/// Runs of ASCII are detected four UTF-16 code units at a time and copied
+/// without going through the general encoder.
+template <typename CharT>
+inline void wide_to_utf8(const CharT* start, const CharT* end, std::string& out) {
+  static_assert(
+      sizeof(CharT) == 2 || sizeof(CharT) == 4,
+      "wide_to_utf8 expects UTF-16 or UTF-32 code units");
+
+  // Worst case: 3 bytes per UTF-16 code unit, 4 bytes per UTF-32 code unit.
+  const size_t max_size = (end - start) * (sizeof(CharT) == 2 ? 3 : 4);
+  if (out.size() < max_size) {
+    out.resize(max_size);
+  }
+  char* dst = &out[0];
+  char* const begin = dst;
+
+  while (start < end) {
+    if (sizeof(CharT) == 2 && end - start >= 4) {
+      uint64_t chunk;
+      std::memcpy(&chunk, start, sizeof(chunk));
+      if ((chunk & 0xFF80FF80FF80FF80ULL) == 0) {
+        // Four ASCII code units; NULs still end the string.
+        int i = 0;
+        for (; i < 4 && start[i] != 0; ++i) {
+          *dst++ = static_cast<char>(start[i]);
+        }
+        if (i < 4) {
+          break;
+        }
+        start += 4;
+        continue;
+      }
+    }
+
+    uint32_t cp = static_cast<uint32_t>(*start++);
+    if (cp == 0) {
+      break;
+    }
+    if (sizeof(CharT) == 2 && cp >= 0xD800 && cp <= 0xDFFF) {
+      if (cp <= 0xDBFF && start < end &&
+          static_cast<uint32_t>(*start) >= 0xDC00 &&
+          static_cast<uint32_t>(*start) <= 0xDFFF) {
+        cp = 0x10000 + ((cp - 0xD800) << 10) +
+             (static_cast<uint32_t>(*start++) - 0xDC00);
+      } else {
+        cp = 0xFFFD;
+      }
+    } else if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+      cp = 0xFFFD;
+    }
+
+    if (cp < 0x80) {
+      *dst++ = static_cast<char>(cp);
+    } else if (cp < 0x800) {
+      *dst++ = static_cast<char>(0xC0 | (cp >> 6));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+      *dst++ = static_cast<char>(0xE0 | (cp >> 12));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+      *dst++ = static_cast<char>(0xF0 | (cp >> 18));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  }
+
+  out.resize(dst - begin);
+}
+
+} // namespace odbc
@@ -2,9 +2,7 @@
 #include <string>
 #include <future>
 #include "utils.h"
-#if !defined(_WIN32) && !defined(_WIN64)
-#include <signal.h>
-#endif
+#include "execution_pool.h"
 
 #ifndef SQL_DRIVER_CONN_ATTR_BASE
     #define SQL_DRIVER_CONN_ATTR_BASE   0x00004000
@@ -82,36 +80,24 @@ namespace utils {
     }
   }
 
-  void run_interruptible(const std::function<void()>& exec_fn, const std::function<void()>& cancel_fn,
-                         const std::function<void()>& cleanup_fn)
+  std::future<void> run_async(const std::function<void()>& exec_fn)
   {
-    std::exception_ptr eptr;
-#if !defined(_WIN32) && !defined(_WIN64)
-    sigset_t set, old_set;
-    sigemptyset(&set);
-    sigaddset(&set, SIGINT);
-    int rc = pthread_sigmask(SIG_BLOCK, &set, &old_set);
-    if ( rc != 0 )
-    {
-      // Unable to properly mask SIGINT from execution thread
-      raise_warning("Unexpected behavior when creating execution thread.  Signals to interrupt execution may not be caught.");
-    }
-#endif
-    auto future = std::async(std::launch::async, [&exec_fn, &eptr]() {
-      try {
-        exec_fn();
-      } catch (...) {
-        eptr = std::current_exception();
-      }
-      return;
-    });
-#if !defined(_WIN32) && !defined(_WIN64)
-    pthread_sigmask(SIG_SETMASK, &old_set, NULL);
-#endif
+    return execution_pool::instance().submit(exec_fn);
+  }
+
+  bool wait_interruptible(std::future<void>& future, const std::function<void()>& cancel_fn,
+                          std::chrono::steady_clock::time_point deadline)
+  {
+    bool timed_out = false;
     std::future_status status;
     do {
-      status = future.wait_for(std::chrono::seconds(1));
+      status = future.wait_for(std::chrono::milliseconds(100));
       if (status != std::future_status::ready) {
+        if (!timed_out && std::chrono::steady_clock::now() > deadline) {
+          // Cancel once, then keep waiting for the driver to give up.
+          timed_out = true;
+          cancel_fn();
+        }
         try { Rcpp::checkUserInterrupt(); }
         catch (const Rcpp::internal::InterruptedException& e) {
           raise_message("Caught user interrupt, attempting a clean exit...");
@@ -119,12 +105,48 @@ namespace utils {
         } catch (...) { throw; }
       }
     } while (status != std::future_status::ready);
-    if (eptr) {
+    return timed_out;
+  }
+
+  void finish_async(std::future<void>& future, const std::function<void()>& cleanup_fn)
+  {
+    try { future.get(); }
+    catch (const odbc_error& e) { cleanup_fn(); raise_error(e); }
+    catch (...) {
       // An exception was thrown in the thread
-      try { cleanup_fn(); std::rethrow_exception(eptr); }
-      catch (const odbc_error& e) { raise_error(e); }
-      catch (...) { raise_message("Unknown exception while executing"); throw; };
+      cleanup_fn();
+      raise_message("Unknown exception while executing");
+      throw;
+    };
+  }
+
+  cancel_timer::cancel_timer(
+      std::chrono::steady_clock::time_point deadline,
+      std::function<void()> cancel_fn)
+      : stopped_(false) {
+    if (deadline == std::chrono::steady_clock::time_point::max()) {
+      return;
+    }
+    done_ = execution_pool::instance().submit([this, deadline, cancel_fn]() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (stopped_cv_.wait_until(lock, deadline, [this]() { return stopped_; })) {
+        return;
+      }
+      try { cancel_fn(); }
+      catch (...) {}
+    });
+  }
+
+  cancel_timer::~cancel_timer() {
+    if (!done_.valid()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
     }
+    stopped_cv_.notify_one();
+    done_.wait();
   }
 
   void raise_message(const std::string& message) {
@@ -6,6 +6,11 @@
 #endif
 
 #include <Rcpp.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
 #include "sql_types.h"
 #include "odbc_result.h"
 #include "nanodbc.h"
@@ -46,22 +51,65 @@ namespace utils {
   /// \return A shared pointer to the buffer containing the serialized structure.
   std::shared_ptr< void > serialize_azure_token( const std::string& token );
 
-  /// \brief Wrapper to allow for interruptible execution of argument function
+  /// \brief Run the argument function on a thread from `execution_pool`.
   ///
-  /// The execution function is relegated to a separate thread.
-  /// On the main thread, we wait for the execution to complete while
-  /// at the same time checking for user interrupts every one second.
+  /// SIGINT is masked in pool threads so that user interrupts are
+  /// delivered to the main [R] thread.  The function must not call into
+  /// [R].
   ///
   /// \param exec_fn Function executed on a separate thread.  Exceptions
-  /// are caught and re-thrown on the main thread.
+  /// are stored in the returned future.
+  std::future<void> run_async(const std::function<void()>& exec_fn);
+
+  /// \brief Wait for a future returned by `run_async` to become ready,
+  /// checking for user interrupts every 100 milliseconds.
+  ///
   /// \param cancel_fn Function executed on main thread in the event a
-  /// user interrupt is caught.  This function should cause failure on
-  /// thread.
-  /// \param cleanup_fn Function executed on main thread to cleanup
-  /// resources.  When executing, caller can assume thread execution
-  /// has stopped.
-  void run_interruptible(const std::function<void()>& exec_fn, const std::function<void()>& cancel_fn,
-                         const std::function<void()>& cleanup_fn);
+  /// user interrupt is caught, or `deadline` passes.  This function should
+  /// cause failure on thread.
+  /// \param deadline Time after which the execution is cancelled.
+  /// \return Whether the execution was cancelled because `deadline`
+  /// passed.  The future is ready in either case.
+  bool wait_interruptible(
+      std::future<void>& future,
+      const std::function<void()>& cancel_fn,
+      std::chrono::steady_clock::time_point deadline =
+          std::chrono::steady_clock::time_point::max());
+
+  /// \brief Collect the outcome of a ready future returned by `run_async`.
+  ///
+  /// Exceptions thrown on the thread are re-thrown on the main thread,
+  /// as [R] errors for `odbc_error`, after calling `cleanup_fn`.
+  void finish_async(std::future<void>& future, const std::function<void()>& cleanup_fn);
+
+  /// \brief Calls a function from a separate thread once a deadline
+  /// passes, unless destroyed before.
+  ///
+  /// For work that stays on the main thread, like fetching: the ODBC
+  /// driver manager allows `SQLCancel` on a statement from another thread
+  /// while the main thread is blocked in `SQLFetch` or `SQLGetData` on it.
+  /// The timer waits on an `execution_pool` thread, where SIGINT is
+  /// masked; nothing is started if the deadline is `time_point::max()`.
+  class cancel_timer {
+  public:
+    /// \param cancel_fn Function executed on the timer thread.  Exceptions
+    /// are ignored.
+    cancel_timer(
+        std::chrono::steady_clock::time_point deadline,
+        std::function<void()> cancel_fn);
+
+    /// \brief Stops the timer, waiting for `cancel_fn` if it is running.
+    ~cancel_timer();
+
+    cancel_timer(cancel_timer const&) = delete;
+    cancel_timer& operator=(cancel_timer const&) = delete;
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable stopped_cv_;
+    bool stopped_;
+    std::future<void> done_;
+  };
 
   /// \brief Entry point for package::cli::cli_inform
   ///